@@ -0,0 +1,95 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+// Counts heap allocations made through operator new on every thread, to
+// check that steady-state play never touches the heap. Exactly one
+// translation unit defines ALLOC_COUNTER_IMPLEMENTATION before including
+// this, which replaces the global operator new and delete, the
+// std::align_val_t forms for over-aligned types included. Direct malloc
+// calls (from C libraries or the GL driver) are not seen.
+
+struct AllocationCounts {
+    long long allocations = 0;
+    long long bytes = 0;
+
+    AllocationCounts operator-(const AllocationCounts& since) const {
+        return { allocations - since.allocations, bytes - since.bytes };
+    }
+};
+
+inline std::atomic<long long> allocationTotal{ 0 };
+inline std::atomic<long long> allocationBytes{ 0 };
+
+inline AllocationCounts allocationCounts() {
+    return { allocationTotal.load(std::memory_order_relaxed), allocationBytes.load(std::memory_order_relaxed) };
+}
+
+#ifdef ALLOC_COUNTER_IMPLEMENTATION
+#include <cstdlib>
+#include <new>
+
+// Kept out of line: GCC otherwise inlines free() into callers that it
+// thinks got their pointer from the library's operator new, and warns. The
+// same goes for an array new it can see forward to the scalar one.
+#if defined(__GNUC__)
+#define ALLOC_COUNTER_NOINLINE __attribute__((noinline))
+#else
+#define ALLOC_COUNTER_NOINLINE
+#endif
+
+void* operator new(std::size_t size) {
+    allocationTotal.fetch_add(1, std::memory_order_relaxed);
+    allocationBytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+ALLOC_COUNTER_NOINLINE void* operator new[](std::size_t size) { return operator new(size); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return operator new(size);
+    }
+    catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept { return operator new(size, tag); }
+
+// aligned_alloc wants the size to be a multiple of the alignment.
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    allocationTotal.fetch_add(1, std::memory_order_relaxed);
+    allocationBytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+    std::size_t align = static_cast<std::size_t>(alignment);
+    std::size_t rounded = size ? (size + align - 1) / align * align : align;
+    if (void* p = std::aligned_alloc(align, rounded)) return p;
+    throw std::bad_alloc();
+}
+
+ALLOC_COUNTER_NOINLINE void* operator new[](std::size_t size, std::align_val_t alignment) { return operator new(size, alignment); }
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try {
+        return operator new(size, alignment);
+    }
+    catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t& tag) noexcept {
+    return operator new(size, alignment, tag);
+}
+
+ALLOC_COUNTER_NOINLINE void operator delete(void* p) noexcept { std::free(p); }
+ALLOC_COUNTER_NOINLINE void operator delete[](void* p) noexcept { std::free(p); }
+ALLOC_COUNTER_NOINLINE void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+ALLOC_COUNTER_NOINLINE void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+ALLOC_COUNTER_NOINLINE void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+ALLOC_COUNTER_NOINLINE void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+ALLOC_COUNTER_NOINLINE void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+ALLOC_COUNTER_NOINLINE void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+#endif
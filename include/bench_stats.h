@@ -0,0 +1,9 @@
+#pragma once
+
+// Small helpers shared by the batch reports (--bench, --farm, --validate).
+
+// Whole items per second for a batch report. 0 when nothing was timed: an
+// empty batch gives 0/0, and casting NaN or inf to an integer is undefined.
+inline long long perSecond(double count, double seconds) {
+    return seconds > 0.0 ? static_cast<long long>(count / seconds) : 0;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// One block of memory that a level chunk carves all its entity lists (and
+// any other per-chunk data) out of by bumping an offset, while the chunk is
+// built and handed to the world. Nothing in it is destroyed one by one:
+// reset() drops everything in O(1) and the block is reused by the next
+// chunk, so building chunks never fragments the heap or frees per entity.
+// Only trivially destructible types go in.
+//
+// This is staging only. Splicing a chunk into the world spawns each of its
+// entities in the world's registry, and the arena goes back to its owner
+// (a queue slot or a scratch chunk) for the next chunk; no arena outlives
+// the splice or owns a live entity.
+class ChunkArena {
+public:
+    ChunkArena() = default;
+    ChunkArena(const ChunkArena&) = delete;
+    ChunkArena& operator=(const ChunkArena&) = delete;
+
+    // Bytes to hold n T's, whatever the offset they start at.
+    template <typename T>
+    static constexpr size_t bytesFor(size_t n) { return n * sizeof(T) + alignof(T) - 1; }
+
+    // Replaces the block with one of `bytes`, dropping everything in it.
+    void reserve(size_t bytes) {
+        block.reset(new unsigned char[bytes]);
+        capacityValue = bytes;
+        used = 0;
+    }
+
+    void reset() { used = 0; }
+
+    // Uninitialized room for n T's, or null if the block is out of room.
+    template <typename T>
+    T* allocate(size_t n) {
+        static_assert(std::is_trivially_destructible<T>::value, "arena memory is dropped without destructors");
+        size_t offset = (used + alignof(T) - 1) & ~(alignof(T) - 1);
+        if (!block || offset + n * sizeof(T) > capacityValue) return nullptr;
+        used = offset + n * sizeof(T);
+        return reinterpret_cast<T*>(block.get() + offset);
+    }
+
+    size_t bytesUsed() const { return used; }
+    size_t capacity() const { return capacityValue; }
+
+private:
+    std::unique_ptr<unsigned char[]> block;
+    size_t capacityValue = 0;
+    size_t used = 0;
+};
+
+// A list over arena memory with a capacity fixed when it is bound. Callers
+// size it so appends never overflow; there is no growth path, and
+// overflowing is a bug in the sizing, caught by the assert.
+template <typename T>
+class ArenaList {
+public:
+    void bind(T* storage, size_t capacity) {
+        assert((storage || capacity == 0) && "arena block too small for the list");
+        items = storage;
+        capacityValue = capacity;
+        count = 0;
+    }
+
+    void clear() { count = 0; }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        assert(count < capacityValue && "chunk outgrew its arena reservation");
+        return *new (items + count++) T(std::forward<Args>(args)...);
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+
+    size_t size() const { return count; }
+    size_t capacity() const { return capacityValue; }
+    bool empty() const { return count == 0; }
+
+    T& operator[](size_t i) { return items[i]; }
+    const T& operator[](size_t i) const { return items[i]; }
+    T& back() { return items[count - 1]; }
+    const T& back() const { return items[count - 1]; }
+
+    T* begin() { return items; }
+    T* end() { return items + count; }
+    const T* begin() const { return items; }
+    const T* end() const { return items + count; }
+
+private:
+    T* items = nullptr;
+    size_t capacityValue = 0;
+    size_t count = 0;
+};
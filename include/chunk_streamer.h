@@ -0,0 +1,167 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+
+#include "level_chunks.h"
+#include "spsc_queue.h"
+
+// Counters for the simulation side of the hand-off. A stall is a chunk the
+// world needed that the worker didn't have ready, so it was generated inline.
+struct ChunkStreamStats {
+    long long taken = 0;
+    long long stalls = 0;
+    long long discarded = 0;      // stale chunks: from before a restart, or passed
+    long long droppedRestarts = 0; // restarts the full request queue refused
+    long long depthTotal = 0;
+    size_t minDepth = ~size_t(0);
+
+    void print(std::ostream& out) const {
+        long long requests = taken + stalls;
+        if (requests == 0) return;
+        out << "chunks: " << taken << " from worker  stalls: " << stalls
+            << "  discarded: " << discarded << "  dropped restarts: " << droppedRestarts
+            << "  queue depth avg/min: " << static_cast<double>(depthTotal) / requests << " / " << minDepth << std::endl;
+    }
+};
+
+// A worker thread that keeps up to kAhead chunks generated past the world's
+// streaming cursor, handed over through a wait-free SPSC queue. The world
+// takes chunks in order with take()/release(); restart() points the worker at
+// a new level. Neither thread ever waits on the other: the worker naps when
+// the queue is full, and the world generates a chunk itself when the one it
+// needs isn't there yet. The world publishes the next index it will ask
+// for, so a worker that fell behind skips to it instead of building chunks
+// take() would only throw away.
+class ChunkStreamer {
+public:
+    static constexpr size_t kAhead = 4;
+
+    ~ChunkStreamer() { stop(); }
+
+    // Sizes every queued chunk, and the worker's own scratch, for
+    // platformsPerChunk, and returns once the worker has done so: streaming
+    // never allocates after this.
+    void start(int platformsPerChunk) {
+        if (worker.joinable()) return;
+        for (size_t i = 0; i < chunks.capacity(); ++i) chunks.slotAt(i).chunk.reserve(platformsPerChunk);
+        running = true;
+        std::atomic<bool> reserved{ false };
+        worker = std::thread([this, platformsPerChunk, &reserved] {
+            belowChunkScratch().reserve(platformsPerChunk);
+            reserved.store(true, std::memory_order_release);
+            run();
+        });
+        while (!reserved.load(std::memory_order_acquire)) std::this_thread::yield();
+    }
+
+    void stop() {
+        running = false;
+        if (worker.joinable()) worker.join();
+    }
+
+    // Simulation side. Chunks from before the restart still in the queue are
+    // discarded as take() meets them. If the request queue is full (the
+    // worker hasn't run since several restarts) the request is dropped and
+    // counted, and the world generates inline until the next one gets
+    // through.
+    void restart(uint64_t seed, const LevelParams& params, long long firstIndex) {
+        ++epoch;
+        publishCursor(firstIndex);
+        if (Request* r = requests.pushSlot()) {
+            *r = { seed, params, firstIndex, epoch };
+            requests.commitPush();
+        }
+        else {
+            stats.droppedRestarts++;
+        }
+    }
+
+    // Simulation side: chunk `index` if the worker has it ready, else null.
+    // A returned chunk stays valid until release().
+    const LevelChunk* take(long long index) {
+        stats.depthTotal += static_cast<long long>(chunks.size());
+        stats.minDepth = std::min(stats.minDepth, chunks.size());
+        while (Streamed* s = chunks.front()) {
+            if (s->epoch == epoch && s->chunk.index == index) {
+                stats.taken++;
+                return &s->chunk;
+            }
+            if (s->epoch == epoch && s->chunk.index > index) break;
+            chunks.pop();
+            stats.discarded++;
+        }
+        // The world builds this one itself; the worker's next is after it.
+        publishCursor(index + 1);
+        stats.stalls++;
+        return nullptr;
+    }
+
+    void release() { chunks.pop(); }
+
+    size_t queueDepth() const { return chunks.size(); }
+
+    ChunkStreamStats stats;
+
+private:
+    struct Request {
+        uint64_t seed;
+        LevelParams params;
+        long long firstIndex;
+        unsigned epoch;
+    };
+
+    struct Streamed {
+        unsigned epoch = 0;
+        LevelChunk chunk;
+    };
+
+    // The cursor packs the epoch's low 16 bits over a 48-bit chunk index, so
+    // the worker can tell whether it refers to the level it is building.
+    static constexpr int kCursorEpochShift = 48;
+    static constexpr uint64_t kCursorIndexMask = (uint64_t(1) << kCursorEpochShift) - 1;
+
+    static uint64_t cursorEpoch(unsigned e) { return e & 0xffff; }
+
+    void publishCursor(long long index) {
+        cursor.store((cursorEpoch(epoch) << kCursorEpochShift) | (static_cast<uint64_t>(index) & kCursorIndexMask),
+                     std::memory_order_relaxed);
+    }
+
+    void run() {
+        Request current = {};
+        bool active = false;
+        long long nextIndex = 0;
+        while (running.load(std::memory_order_relaxed)) {
+            while (Request* r = requests.front()) {
+                current = *r;
+                requests.pop();
+                nextIndex = current.firstIndex;
+                active = true;
+            }
+            Streamed* slot = active ? chunks.pushSlot() : nullptr;
+            if (!slot) {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+                continue;
+            }
+            uint64_t wanted = cursor.load(std::memory_order_relaxed);
+            if ((wanted >> kCursorEpochShift) == cursorEpoch(current.epoch)) {
+                nextIndex = std::max(nextIndex, static_cast<long long>(wanted & kCursorIndexMask));
+            }
+            generateChunk(current.params, current.seed, nextIndex++, slot->chunk);
+            slot->epoch = current.epoch;
+            chunks.commitPush();
+        }
+    }
+
+    SpscQueue<Streamed, kAhead> chunks;  // worker -> simulation
+    SpscQueue<Request, 4> requests;      // simulation -> worker
+    unsigned epoch = 0;                  // simulation side
+    std::atomic<uint64_t> cursor{ 0 };   // simulation -> worker: next index wanted
+    std::atomic<bool> running{ false };
+    std::thread worker;
+};
@@ -0,0 +1,32 @@
+#pragma once
+
+// What the player picked up this tick. Collectibles only describe their
+// effect; the pickup systems decide what it does to the game state.
+struct PickupEffects {
+    int coins = 0;
+    bool boost = false;
+};
+
+// Collectible types. Each has a fixed size and a static apply() that records
+// its effect, so the set is closed and every call on it is resolved at
+// compile time (see CollectibleViews in ecs_systems.h). The records are where
+// a level chunk puts each item; in the world it is an entity.
+struct Coin {
+    static constexpr float size = 15.0f;
+    float x, y;
+
+    Coin() = default;
+    Coin(float startX, float startY) : x(startX), y(startY) {}
+
+    static void apply(PickupEffects& effects) { effects.coins++; }
+};
+
+struct HighJumpPowerUp {
+    static constexpr float size = 20.0f;
+    float x, y;
+
+    HighJumpPowerUp() = default;
+    HighJumpPowerUp(float startX, float startY) : x(startX), y(startY) {}
+
+    static void apply(PickupEffects& effects) { effects.boost = true; }
+};
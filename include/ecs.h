@@ -0,0 +1,232 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Entity ids: a 20-bit slot index and a 12-bit generation, so an id kept
+// after its entity was destroyed doesn't alias whatever reuses the slot. A
+// slot whose generation has reached kMaxGeneration is retired rather than
+// wrapped, and the last index is never handed out, so kNoEntity is never a
+// live id. A game reuses a few dozen slots for every entity it streams in;
+// 4096 generations each keep a long game from retiring them (and growing
+// the registry) before its next reset clears it.
+using Entity = uint32_t;
+
+constexpr uint32_t kEntityIndexBits = 20;
+constexpr uint32_t kEntityIndexMask = (1u << kEntityIndexBits) - 1;
+constexpr uint32_t kMaxGeneration = 0xfff;
+constexpr uint32_t kMaxEntitySlots = kEntityIndexMask; // index 0xfffff is kNoEntity's
+constexpr Entity kNoEntity = ~0u;
+
+inline uint32_t entityIndex(Entity e) { return e & kEntityIndexMask; }
+inline uint32_t entityGeneration(Entity e) { return e >> kEntityIndexBits; }
+
+// Copy-assigns keeping at least the source's capacity, so a copy that is
+// refreshed every tick (a render snapshot) allocates once, up front, and not
+// each time the source grows past the size it last copied.
+template <typename T>
+void assignKeepingCapacity(std::vector<T>& to, const std::vector<T>& from) {
+    if (to.capacity() < from.capacity()) to.reserve(from.capacity());
+    to = from;
+}
+
+// One component type as a sparse set: the components packed in a dense
+// array (with their owners alongside), and a sparse table from entity slot
+// to dense position. Removal swaps the last component into the hole, so the
+// array stays packed and iteration never skips.
+template <typename T>
+class ComponentPool {
+public:
+    ComponentPool() = default;
+    ComponentPool(const ComponentPool&) = default;
+    ComponentPool& operator=(const ComponentPool& other) {
+        assignKeepingCapacity(dense, other.dense);
+        assignKeepingCapacity(owners, other.owners);
+        assignKeepingCapacity(sparse, other.sparse);
+        return *this;
+    }
+
+    bool has(uint32_t index) const { return index < sparse.size() && sparse[index] != kAbsent; }
+
+    T& get(uint32_t index) { return dense[sparse[index]]; }
+    const T& get(uint32_t index) const { return dense[sparse[index]]; }
+
+    template <typename... Args>
+    T& add(Entity e, Args&&... args) {
+        uint32_t index = entityIndex(e);
+        if (index >= sparse.size()) sparse.resize(index + 1, kAbsent);
+        if (sparse[index] != kAbsent) return dense[sparse[index]] = T{ std::forward<Args>(args)... };
+        sparse[index] = static_cast<uint32_t>(dense.size());
+        owners.push_back(e);
+        dense.push_back(T{ std::forward<Args>(args)... });
+        return dense.back();
+    }
+
+    void remove(uint32_t index) {
+        if (!has(index)) return;
+        uint32_t hole = sparse[index];
+        uint32_t last = static_cast<uint32_t>(dense.size() - 1);
+        if (hole != last) {
+            dense[hole] = std::move(dense[last]);
+            owners[hole] = owners[last];
+            sparse[entityIndex(owners[hole])] = hole;
+        }
+        dense.pop_back();
+        owners.pop_back();
+        sparse[index] = kAbsent;
+    }
+
+    void reserve(size_t n) {
+        dense.reserve(n);
+        owners.reserve(n);
+        sparse.reserve(n);
+    }
+
+    void clear() {
+        dense.clear();
+        owners.clear();
+        sparse.clear();
+    }
+
+    // Dense order: k-th component and its owner.
+    size_t size() const { return dense.size(); }
+    T& at(size_t k) { return dense[k]; }
+    const T& at(size_t k) const { return dense[k]; }
+    Entity owner(size_t k) const { return owners[k]; }
+
+private:
+    static constexpr uint32_t kAbsent = ~0u;
+
+    std::vector<T> dense;
+    std::vector<Entity> owners;
+    std::vector<uint32_t> sparse;
+};
+
+template <typename T, typename... List>
+struct TypeInList : std::disjunction<std::is_same<T, List>...> {};
+
+// Entities and one pool per component type, all fixed at compile time, so
+// each<...>() resolves every pool statically and a query for a type the
+// registry doesn't hold fails to compile.
+//
+// Structural changes (create, destroy, add, remove) must not happen inside
+// each(); systems queue them and apply them after the pass.
+template <typename... Components>
+class Registry {
+public:
+    Registry() = default;
+    Registry(const Registry&) = default;
+    Registry& operator=(const Registry& other) {
+        pools = other.pools;
+        assignKeepingCapacity(generations, other.generations);
+        assignKeepingCapacity(freeSlots, other.freeSlots);
+        retiredSlots = other.retiredSlots;
+        return *this;
+    }
+
+    // kNoEntity once every slot is live or retired.
+    Entity create() {
+        uint32_t index;
+        if (!freeSlots.empty()) {
+            index = freeSlots.back();
+            freeSlots.pop_back();
+        }
+        else if (generations.size() < kMaxEntitySlots) {
+            index = static_cast<uint32_t>(generations.size());
+            generations.push_back(0);
+        }
+        else {
+            return kNoEntity;
+        }
+        return (generations[index] << kEntityIndexBits) | index;
+    }
+
+    void destroy(Entity e) {
+        if (!alive(e)) return;
+        uint32_t index = entityIndex(e);
+        (pool<Components>().remove(index), ...);
+        if (generations[index] == kMaxGeneration) {
+            // Another generation would wrap to 0 and revive old ids; the
+            // slot stays dead instead.
+            generations[index] = kRetired;
+            ++retiredSlots;
+            return;
+        }
+        generations[index]++;
+        freeSlots.push_back(index);
+    }
+
+    bool alive(Entity e) const {
+        uint32_t index = entityIndex(e);
+        return index < generations.size() && generations[index] == entityGeneration(e);
+    }
+
+    size_t size() const { return generations.size() - freeSlots.size() - retiredSlots; }
+
+    void reserve(size_t n) {
+        generations.reserve(n);
+        freeSlots.reserve(n);
+        (pool<Components>().reserve(n), ...);
+    }
+
+    void clear() {
+        generations.clear();
+        freeSlots.clear();
+        retiredSlots = 0;
+        (pool<Components>().clear(), ...);
+    }
+
+    template <typename T>
+    ComponentPool<T>& pool() {
+        static_assert(TypeInList<T, Components...>::value, "component type is not in this registry");
+        return std::get<ComponentPool<T>>(pools);
+    }
+
+    template <typename T>
+    const ComponentPool<T>& pool() const {
+        static_assert(TypeInList<T, Components...>::value, "component type is not in this registry");
+        return std::get<ComponentPool<T>>(pools);
+    }
+
+    template <typename T, typename... Args>
+    T& add(Entity e, Args&&... args) { return pool<T>().add(e, std::forward<Args>(args)...); }
+
+    template <typename T>
+    void remove(Entity e) { pool<T>().remove(entityIndex(e)); }
+
+    template <typename T>
+    bool has(Entity e) const { return pool<T>().has(entityIndex(e)); }
+
+    template <typename T>
+    T& get(Entity e) { return pool<T>().get(entityIndex(e)); }
+
+    template <typename T>
+    const T& get(Entity e) const { return pool<T>().get(entityIndex(e)); }
+
+    // Calls f(entity, First&, Rest&...) for every entity that has all of the
+    // listed components. Walks First's dense array front to back, so list
+    // the rarest component first; the rest are looked up per entity.
+    template <typename First, typename... Rest, typename F>
+    void each(F&& f) {
+        ComponentPool<First>& lead = pool<First>();
+        for (size_t k = 0; k < lead.size(); ++k) {
+            Entity e = lead.owner(k);
+            [[maybe_unused]] uint32_t index = entityIndex(e);
+            if (!(pool<Rest>().has(index) && ...)) continue;
+            f(e, lead.at(k), pool<Rest>().get(index)...);
+        }
+    }
+
+private:
+    // Above any 12-bit generation, so no id matches a retired slot.
+    static constexpr uint32_t kRetired = kMaxGeneration + 1;
+
+    std::tuple<ComponentPool<Components>...> pools;
+    std::vector<uint32_t> generations;
+    std::vector<uint32_t> freeSlots;
+    size_t retiredSlots = 0;
+};
@@ -0,0 +1,254 @@
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+
+#include "collectibles.h"
+#include "ecs.h"
+#include "game_events.h"
+#include "platform_store.h"
+#include "ring_buffer.h"
+
+// The game's entities as components, and the per-tick systems GameWorld::step
+// runs over them. Each system queries only the components it reads or
+// writes: gravity then movement, wall bounce for moving platforms, screen
+// wrap for the player, swept landing, AABB pickup, then what a pickup does.
+
+struct Position { float x, y; };
+struct Velocity { float x, y; };
+struct Gravity { float strength; };
+struct Body { float halfWidth, halfHeight; };
+struct Wraps {};      // leaves one side of the screen and comes in the other
+struct WallBounce {}; // reverses at the side walls (moving platforms)
+
+struct PlatformComponent {
+    PlatformType type;
+    bool broken;
+};
+
+// A coin or power-up; which one is known from the view that holds it.
+struct Collectible {
+    bool active;
+};
+
+// A body that bounces off platforms, higher while a high-jump boost lasts.
+struct Jumper {
+    float strength;
+    float boostedStrength;
+    bool boosted = false;
+    int boostTicks = 0;
+    bool lastLandingBroke = false;
+};
+
+using GameRegistry = Registry<Position, Velocity, Gravity, Body, Wraps, WallBounce,
+                              PlatformComponent, Collectible, Jumper, PickupEffects>;
+
+// Ids of one kind of entity that never moves vertically (platforms, coins,
+// power-ups), in the order they were spawned, which is increasing y. The
+// level only appends higher entities and the camera only passes them from
+// the bottom, so retiring one advances the head of the ring. Broken
+// platforms and taken items stay as tombstones until they reach the front,
+// which keeps the order for the binary searches below.
+using SortedView = Ring<Entity>;
+
+// Logical index of the first entity in `view` whose top edge is above
+// `value`, or view.size(). Tops are sorted because y is and every entity of
+// a kind has the same height (see landing_kernel.h for platforms).
+inline size_t firstTopAbove(const GameRegistry& reg, const SortedView& view, float value) {
+    size_t lo = 0, hi = view.size();
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        Entity e = view[mid];
+        if (value < reg.get<Position>(e).y + reg.get<Body>(e).halfHeight) hi = mid;
+        else lo = mid + 1;
+    }
+    return lo;
+}
+
+template <typename T>
+struct TypeTag {
+    using type = T;
+};
+
+// One sorted view per collectible type. Passes over the views expand to one
+// loop per type, each specialised for that type.
+template <typename... Types>
+class CollectibleViews {
+public:
+    template <typename T>
+    SortedView& of() { return std::get<View<T>>(views).ids; }
+
+    template <typename T>
+    const SortedView& of() const { return std::get<View<T>>(views).ids; }
+
+    // f(TypeTag<T>(), view) for every type in order.
+    template <typename F>
+    void forEachType(F&& f) {
+        (f(TypeTag<Types>(), of<Types>()), ...);
+    }
+
+    template <typename F>
+    void forEachType(F&& f) const {
+        (f(TypeTag<Types>(), of<Types>()), ...);
+    }
+
+    void clear() {
+        forEachType([](auto, SortedView& view) { view.clear(); });
+    }
+
+    void reserve(size_t n) {
+        forEachType([n](auto, SortedView& view) { view.reserve(n); });
+    }
+
+    size_t size() const {
+        size_t total = 0;
+        forEachType([&](auto, const SortedView& view) { total += view.size(); });
+        return total;
+    }
+
+private:
+    template <typename T>
+    struct View {
+        SortedView ids;
+    };
+
+    std::tuple<View<Types>...> views;
+};
+
+using Collectibles = CollectibleViews<Coin, HighJumpPowerUp>;
+
+inline void gravitySystem(GameRegistry& reg) {
+    reg.each<Gravity, Velocity>([](Entity, Gravity& g, Velocity& v) { v.y -= g.strength; });
+}
+
+// Moving platforms bounce between the side walls; the player leaves one side
+// once fully off screen and comes in the other.
+inline void movementSystem(GameRegistry& reg, int worldWidth) {
+    reg.each<Velocity, Position>([](Entity, Velocity& v, Position& p) {
+        p.x += v.x;
+        p.y += v.y;
+    });
+    reg.each<Wraps, Position, Body>([worldWidth](Entity, Wraps&, Position& p, Body& b) {
+        if (p.x > worldWidth + b.halfWidth) p.x = -b.halfWidth;
+        else if (p.x < -b.halfWidth) p.x = worldWidth + b.halfWidth;
+    });
+    reg.each<WallBounce, Position, Velocity, Body>([worldWidth](Entity, WallBounce&, Position& p, Velocity& v, Body& b) {
+        if (p.x < b.halfWidth || p.x > worldWidth - b.halfWidth) v.x = -v.x;
+    });
+}
+
+// Lands each falling jumper on the lowest intact platform its feet crossed
+// this tick. Only a platform whose top lies in (bottom, previous] can pass
+// the crossing test, so two binary searches narrow the sweep to that band,
+// usually zero or one platform. Raises the landing (and a break) on
+// `events`.
+inline void landingSystem(GameRegistry& reg, const SortedView& platforms, EventBus& events) {
+    reg.each<Jumper, Position, Velocity, Body>([&](Entity, Jumper& j, Position& p, Velocity& v, Body& b) {
+        if (v.y >= 0) return;
+        const float bottom = p.y - b.halfHeight;
+        const float previous = (p.y - v.y) - b.halfHeight;
+        const float left = p.x - b.halfWidth, right = p.x + b.halfWidth;
+        size_t last = firstTopAbove(reg, platforms, previous);
+        for (size_t n = firstTopAbove(reg, platforms, bottom); n < last; ++n) {
+            Entity e = platforms[n];
+            PlatformComponent& pc = reg.get<PlatformComponent>(e);
+            const Position& pp = reg.get<Position>(e);
+            const Body& pb = reg.get<Body>(e);
+            float top = pp.y + pb.halfHeight;
+            bool hit = !pc.broken && right > pp.x - pb.halfWidth && left < pp.x + pb.halfWidth &&
+                       previous >= top && bottom < top;
+            if (!hit) continue;
+
+            bool breakable = pc.type == PLATFORM_BREAKABLE;
+            p.y = top + b.halfHeight;
+            v.y = j.boosted ? j.boostedStrength : j.strength;
+            events.push(EVENT_LANDED, pp.x, pp.y, pc.type);
+            if (breakable) {
+                pc.broken = true;
+                events.push(EVENT_PLATFORM_BROKEN, pp.x, pp.y);
+            }
+            j.lastLandingBroke = breakable;
+            return;
+        }
+    });
+}
+
+// AABB test of one item against a collector's box; a hit deactivates the
+// item, which stays in its view as a tombstone until retired.
+template <typename T>
+inline bool tryCollect(Collectible& item, const Position& at, const Position& p, const Body& b) {
+    if (!item.active) return false;
+
+    bool xOverlap = p.x + b.halfWidth > at.x - T::size / 2 &&
+                    p.x - b.halfWidth < at.x + T::size / 2;
+    bool yOverlap = p.y + b.halfHeight > at.y - T::size / 2 &&
+                    p.y - b.halfHeight < at.y + T::size / 2;
+
+    if (xOverlap && yOverlap) {
+        item.active = false;
+        return true;
+    }
+    return false;
+}
+
+// Broadphase plus narrow phase for every collector and collectible type:
+// binary-search the first item whose top edge is above the collector's
+// bottom, then test forward until an item's bottom edge is above its top.
+// Those are the two y-overlap terms of tryCollect, so nothing outside the
+// window could have been collected. Each collector's PickupEffects holds
+// what it picked up this tick. Returns the number of narrow-phase tests.
+inline int pickupSystem(GameRegistry& reg, Collectibles& collectibles) {
+    int tests = 0;
+    reg.each<PickupEffects, Position, Body>([&](Entity, PickupEffects& fx, Position& p, Body& b) {
+        fx = PickupEffects();
+        const float bottom = p.y - b.halfHeight;
+        const float top = p.y + b.halfHeight;
+        collectibles.forEachType([&](auto tag, SortedView& items) {
+            using T = typename decltype(tag)::type;
+            for (size_t i = firstTopAbove(reg, items, bottom); i < items.size(); ++i) {
+                Entity item = items[i];
+                const Position& at = reg.get<Position>(item);
+                if (!(top > at.y - T::size / 2)) break;
+                ++tests;
+                if (tryCollect<T>(reg.get<Collectible>(item), at, p, b)) T::apply(fx);
+            }
+        });
+    });
+    return tests;
+}
+
+// What this tick's pickups do to a jumper: coins are raised for the score
+// keeper, a high jump boosts bounces for boostDuration ticks. Then the boost
+// counts down, starting on the tick it was picked up.
+inline void pickupEffectSystem(GameRegistry& reg, EventBus& events, int boostDuration) {
+    reg.each<PickupEffects, Jumper, Position>([&](Entity, PickupEffects& fx, Jumper& j, Position& p) {
+        if (fx.coins) events.push(EVENT_COIN_COLLECTED, p.x, p.y, fx.coins);
+        if (fx.boost) {
+            j.boosted = true;
+            j.boostTicks = boostDuration;
+            events.push(EVENT_BOOST_STARTED, p.x, p.y);
+        }
+        if (j.boosted) {
+            j.boostTicks--;
+            if (j.boostTicks <= 0) {
+                j.boosted = false;
+                events.push(EVENT_BOOST_EXPIRED, p.x, p.y);
+            }
+        }
+    });
+}
+
+// Destroys entities from the front of `view` while they are more than their
+// own height below `limit`. Costs one compare per retired entity plus one,
+// whatever is alive above. Returns the number retired.
+inline int cullingSystem(GameRegistry& reg, SortedView& view, float limit) {
+    int retired = 0;
+    while (!view.empty()) {
+        Entity e = view.front();
+        if (!(reg.get<Position>(e).y < limit - 2 * reg.get<Body>(e).halfHeight)) break;
+        reg.destroy(e);
+        view.popFront();
+        ++retired;
+    }
+    return retired;
+}
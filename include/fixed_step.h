@@ -0,0 +1,104 @@
+#pragma once
+
+#include <chrono>
+#include <iostream>
+
+// Step pacing counters. A batch is one beginBatch() call and the ticks it
+// ran; on the simulation thread that is a pass of its loop, not a drawn
+// frame. "Late" is how far behind its scheduled time a tick actually ran;
+// catch-up batches ran more than one tick, and dropped time is what the
+// substep cap threw away when the simulation fell too far behind.
+struct StepPacingStats {
+    long long batches = 0;
+    long long ticks = 0;
+    long long catchUpBatches = 0;
+    long long cappedBatches = 0;
+    double droppedSeconds = 0.0;
+    double maxLateSeconds = 0.0;
+    double totalLateSeconds = 0.0;
+    double minBatchSeconds = 1e9;
+    double maxBatchSeconds = 0.0;
+    double totalBatchSeconds = 0.0;
+
+    void print(std::ostream& out) const {
+        if (batches == 0) return;
+        out << "step batches: " << batches << "  ticks: " << ticks
+            << "  catch-up batches: " << catchUpBatches
+            << "  capped batches: " << cappedBatches
+            << "  dropped: " << droppedSeconds * 1000.0 << " ms\n"
+            << "batch interval ms min/avg/max: " << minBatchSeconds * 1000.0 << " / "
+            << totalBatchSeconds / batches * 1000.0 << " / " << maxBatchSeconds * 1000.0
+            << "  tick late ms avg/max: "
+            << (ticks ? totalLateSeconds / ticks * 1000.0 : 0.0) << " / " << maxLateSeconds * 1000.0
+            << std::endl;
+    }
+};
+
+// Accumulator for a fixed simulation rate independent of how often frames are
+// drawn. Call beginBatch() each pass, run tick() that many times, and render
+// with alpha() to blend the previous and current simulation states.
+class FixedStepClock {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit FixedStepClock(double tickSeconds = 0.016, int maxSubsteps = 5)
+        : tickSeconds(tickSeconds), maxSubsteps(maxSubsteps) {}
+
+    void restart() {
+        last = Clock::now();
+        accumulator = 0.0;
+        started = true;
+    }
+
+    // Returns how many fixed ticks are due since the last batch, never more
+    // than maxSubsteps; the rest of a long stall is dropped rather than
+    // replayed.
+    int beginBatch() {
+        auto now = Clock::now();
+        if (!started) {
+            last = now;
+            started = true;
+        }
+        double batchSeconds = std::chrono::duration<double>(now - last).count();
+        last = now;
+
+        stats.batches++;
+        stats.totalBatchSeconds += batchSeconds;
+        if (batchSeconds < stats.minBatchSeconds) stats.minBatchSeconds = batchSeconds;
+        if (batchSeconds > stats.maxBatchSeconds) stats.maxBatchSeconds = batchSeconds;
+
+        accumulator += batchSeconds;
+        int due = static_cast<int>(accumulator / tickSeconds);
+        if (due > maxSubsteps) {
+            stats.cappedBatches++;
+            stats.droppedSeconds += (due - maxSubsteps) * tickSeconds;
+            accumulator -= (due - maxSubsteps) * tickSeconds;
+            due = maxSubsteps;
+        }
+        if (due > 1) stats.catchUpBatches++;
+        return due;
+    }
+
+    // Consumes one due tick and records how late it is relative to its slot.
+    void tick() {
+        double late = accumulator - tickSeconds;
+        accumulator -= tickSeconds;
+        stats.ticks++;
+        stats.totalLateSeconds += late;
+        if (late > stats.maxLateSeconds) stats.maxLateSeconds = late;
+    }
+
+    // Fraction of a tick elapsed since the last simulated state.
+    float alpha() const { return static_cast<float>(accumulator / tickSeconds); }
+
+    double secondsUntilNextTick() const { return tickSeconds - accumulator; }
+
+    const double tickSeconds;
+    const int maxSubsteps;
+    StepPacingStats stats;
+
+private:
+    Clock::time_point last;
+    double accumulator = 0.0;
+    bool started = false;
+};
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+
+// Build with -DFRAME_PROFILER=0 to compile every PROFILE_PHASE out.
+#ifndef FRAME_PROFILER
+#define FRAME_PROFILER 1
+#endif
+
+enum ProfilePhase {
+    PHASE_PHYSICS,
+    PHASE_GENERATE,
+    PHASE_REMOVE,
+    PHASE_DRAW,
+    PHASE_SWAP,
+    PHASE_COUNT
+};
+
+inline const char* profilePhaseName(int phase) {
+    static const char* names[PHASE_COUNT] = { "physics", "generate", "remove", "draw", "swap" };
+    return names[phase];
+}
+
+struct PhaseSummary {
+    double min = 0.0, avg = 0.0, p99 = 0.0; // microseconds, over the window
+};
+
+// The last kWindow samples of one phase in a ring, plus lifetime totals.
+class PhaseHistory {
+public:
+    static constexpr int kWindow = 512;
+
+    void add(double micros) {
+        samples[next] = static_cast<float>(micros);
+        next = (next + 1) % kWindow;
+        if (filled < kWindow) ++filled;
+        count++;
+        total += micros;
+        maximum = std::max(maximum, micros);
+    }
+
+    // Sorts a stack copy of the window, so it doesn't allocate.
+    PhaseSummary summary() const {
+        PhaseSummary s;
+        if (filled == 0) return s;
+        float sorted[kWindow];
+        std::copy(samples, samples + filled, sorted);
+        std::sort(sorted, sorted + filled);
+        double sum = 0.0;
+        for (int i = 0; i < filled; ++i) sum += sorted[i];
+        s.min = sorted[0];
+        s.avg = sum / filled;
+        s.p99 = sorted[std::min(filled - 1, filled * 99 / 100)];
+        return s;
+    }
+
+    long long count = 0;
+    double total = 0.0;   // microseconds
+    double maximum = 0.0; // microseconds
+
+private:
+    float samples[kWindow] = {};
+    int next = 0;
+    int filled = 0;
+};
+
+// One per thread, and off until enabled, so headless worlds stepped by the
+// benchmarks and the farm pay one branch per scope.
+class FrameProfiler {
+public:
+    void record(ProfilePhase phase, double seconds) { phases[phase].add(seconds * 1e6); }
+
+    const PhaseHistory& history(int phase) const { return phases[phase]; }
+
+    // Takes the phases this profiler never recorded from `other`; threads
+    // time disjoint phases, so this combines them into one report.
+    void mergeFrom(const FrameProfiler& other) {
+        for (int p = 0; p < PHASE_COUNT; ++p) {
+            if (phases[p].count == 0) phases[p] = other.phases[p];
+        }
+    }
+
+    void print(std::ostream& out) const {
+        out << std::fixed << std::setprecision(1);
+        for (int p = 0; p < PHASE_COUNT; ++p) {
+            PhaseSummary s = phases[p].summary();
+            out << profilePhaseName(p) << ": min " << s.min << " us  avg " << s.avg
+                << " us  p99 " << s.p99 << " us  (" << phases[p].count << " samples)" << std::endl;
+        }
+        out << std::defaultfloat;
+    }
+
+    bool writeCsv(const char* path) const {
+        std::ofstream out(path);
+        if (!out) return false;
+        out << "phase,samples,total_us,max_us,window_min_us,window_avg_us,window_p99_us\n";
+        for (int p = 0; p < PHASE_COUNT; ++p) {
+            const PhaseHistory& h = phases[p];
+            PhaseSummary s = h.summary();
+            out << profilePhaseName(p) << ',' << h.count << ',' << h.total << ',' << h.maximum << ','
+                << s.min << ',' << s.avg << ',' << s.p99 << '\n';
+        }
+        return true;
+    }
+
+    bool enabled = false;
+
+private:
+    PhaseHistory phases[PHASE_COUNT];
+};
+
+inline FrameProfiler& frameProfiler() {
+    thread_local FrameProfiler profiler;
+    return profiler;
+}
+
+// Times its scope as one sample of `phase`. Scopes nest, and a parent records
+// only its own (exclusive) time, so physics doesn't also count the
+// generation it calls.
+class ScopedPhaseTimer {
+public:
+    explicit ScopedPhaseTimer(ProfilePhase p) : phase(p), active(frameProfiler().enabled) {
+        if (!active) return;
+        parent = current();
+        current() = this;
+        start = std::chrono::steady_clock::now();
+    }
+
+    ~ScopedPhaseTimer() {
+        if (!active) return;
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (parent) parent->childSeconds += elapsed;
+        current() = parent;
+        frameProfiler().record(phase, elapsed - childSeconds);
+    }
+
+    ScopedPhaseTimer(const ScopedPhaseTimer&) = delete;
+    ScopedPhaseTimer& operator=(const ScopedPhaseTimer&) = delete;
+
+private:
+    static ScopedPhaseTimer*& current() {
+        thread_local ScopedPhaseTimer* top = nullptr;
+        return top;
+    }
+
+    ProfilePhase phase;
+    bool active;
+    ScopedPhaseTimer* parent = nullptr;
+    double childSeconds = 0.0;
+    std::chrono::steady_clock::time_point start;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#if FRAME_PROFILER
+#define PROFILE_PHASE(phase) ScopedPhaseTimer PROFILE_CONCAT(phaseTimer, __LINE__)(phase)
+#else
+#define PROFILE_PHASE(phase) ((void)0)
+#endif
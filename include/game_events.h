@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+
+// Gameplay events. The simulation appends them as things happen during a
+// tick and the bus hands the whole tick's batch to each subscriber once, at
+// the end of the tick, so the hot code only writes a small record and every
+// consumer (score, telemetry, messages, and later audio or achievements)
+// runs its loop over a batch.
+
+enum GameEventType : uint8_t {
+    EVENT_LANDED,          // value: PlatformType landed on
+    EVENT_PLATFORM_BROKEN,
+    EVENT_COIN_COLLECTED,  // value: coins picked up
+    EVENT_BOOST_STARTED,
+    EVENT_BOOST_EXPIRED,
+    EVENT_GAME_OVER,       // value: DeathCause
+    EVENT_SCORED,          // value: points
+    EVENT_TYPE_COUNT
+};
+
+inline const char* gameEventName(int type) {
+    static const char* names[EVENT_TYPE_COUNT] = { "landed", "platform_broken", "coin_collected",
+                                                   "boost_started", "boost_expired", "game_over", "scored" };
+    return names[type];
+}
+
+struct GameEvent {
+    GameEventType type;
+    int value;
+    float x, y; // where it happened
+};
+
+using EventHandler = void (*)(void* context, const GameEvent* events, int count);
+
+// One tick's events in a fixed buffer that is reused every tick, and a fixed
+// table of subscribers. Neither allocates. A tick raises a handful of events
+// at most; any past kCapacity are dropped and counted.
+//
+// Copying a bus copies neither its pending events nor its subscribers: a
+// copy starts empty, and assignment keeps the target's own subscriptions.
+// A copied world (a render snapshot, say) stepped on its own must not call
+// the original's handlers.
+class EventBus {
+public:
+    static constexpr int kCapacity = 32;
+    static constexpr int kMaxSubscribers = 8;
+
+    EventBus() = default;
+    EventBus(const EventBus&) {}
+    EventBus& operator=(const EventBus&) { return *this; }
+
+    void push(GameEventType type, float x, float y, int value = 0) {
+        if (count == kCapacity) {
+            dropped++;
+            return;
+        }
+        events[count++] = { type, value, x, y };
+    }
+
+    // Returns false if the table is full.
+    bool subscribe(EventHandler handler, void* context) {
+        if (subscriberCount == kMaxSubscribers) return false;
+        subscribers[subscriberCount++] = { handler, context };
+        return true;
+    }
+
+    // The events raised so far this tick.
+    const GameEvent* begin() const { return events; }
+    const GameEvent* end() const { return events + count; }
+    int size() const { return count; }
+
+    // Hands this tick's events to every subscriber in subscription order,
+    // then starts the next tick empty.
+    void dispatch() {
+        if (count == 0) return;
+        for (int i = 0; i < subscriberCount; ++i) subscribers[i].handler(subscribers[i].context, events, count);
+        count = 0;
+    }
+
+    // Drops undelivered events; subscribers stay.
+    void discardPending() { count = 0; }
+
+    long long dropped = 0;
+
+private:
+    struct Subscriber {
+        EventHandler handler;
+        void* context;
+    };
+
+    GameEvent events[kCapacity];
+    int count = 0;
+    Subscriber subscribers[kMaxSubscribers];
+    int subscriberCount = 0;
+};
+
+// Totals per event type: a ready-made telemetry subscriber.
+struct EventCounts {
+    long long counts[EVENT_TYPE_COUNT] = {};
+
+    static void handle(void* context, const GameEvent* events, int count) {
+        EventCounts& self = *static_cast<EventCounts*>(context);
+        for (int i = 0; i < count; ++i) self.counts[events[i].type]++;
+    }
+
+    // `dropped` is the bus's overflow count, which the handler never sees.
+    void print(std::ostream& out, long long dropped) const {
+        out << "events:";
+        for (int t = 0; t < EVENT_TYPE_COUNT; ++t) out << "  " << gameEventName(t) << ' ' << counts[t];
+        out << "  dropped " << dropped << std::endl;
+    }
+};
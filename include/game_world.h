@@ -0,0 +1,328 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <limits>
+
+#include "collectibles.h"
+#include "frame_profiler.h"
+#include "game_events.h"
+#include "chunk_streamer.h"
+#include "ecs_systems.h"
+#include "level_chunks.h"
+#include "platform_store.h"
+
+enum class DeathCause { None, MissedJump, BrokenPlatform };
+
+struct PlayerInput {
+    int moveDir = 0; // -1 left, 0 idle, +1 right
+};
+
+// All simulation state for one game. Has no dependency on GL or GLUT, so any
+// number of worlds can be stepped headless; the GLUT front end only reads it.
+//
+// The player, platforms and collectibles are entities in `registry`, and
+// step() runs the systems in ecs_systems.h over them. The fields above the
+// registry are tuning: the player's components are built from them at
+// reset(), and step() passes the rest to the systems.
+class GameWorld {
+public:
+    int width = 400;
+    int height = 600;
+
+    float playerWidth = 50.0f;
+    float playerHeight = 60.0f;
+    float moveSpeed = DefaultPhysics::moveSpeed;
+    float gravity = DefaultPhysics::gravity;
+    float jumpStrength = DefaultPhysics::jumpStrength;
+    float boostedJumpStrength = DefaultPhysics::boostedJumpStrength;
+    int boostDuration = 300;
+
+    GameRegistry registry;
+    Entity player = kNoEntity;
+    // Platform and collectible ids in increasing y, for the landing and
+    // pickup searches, culling and drawing.
+    SortedView platforms;
+    Collectibles collectibles;
+
+    // Platforms present at spawn, which don't score.
+    int initialPlatforms = 10;
+    float platformSpacing = 80.0f;
+    int platformsPerChunk = 8;
+
+    float cameraY = 0.0f;
+    int score = 0;
+    int coinsCollected = 0;
+    bool gameOver = false;
+    DeathCause deathCause = DeathCause::None;
+    long long ticks = 0;
+
+    // Collectible narrow-phase tests made last tick and since reset.
+    int narrowPhaseTests = 0;
+    long long totalNarrowPhaseTests = 0;
+
+    // Each chunk is generated from (seed, chunk index) alone, so seed
+    // reproduces a run and any chunk can be rebuilt on its own.
+    uint64_t seed = 0;
+    long long nextChunk = 0;
+    // y of the last platform counted for score.
+    float scoredY = 0.0f;
+    // Optional background generator; without one, chunks are built inline.
+    ChunkStreamer* streamer = nullptr;
+    // What happened this tick, handed to subscribers at the end of step().
+    // Subscriptions outlive reset().
+    EventBus events;
+
+    // The jump generation lays the level out for, and the bot plans with.
+    JumpModel jumpModel() const {
+        JumpModel jump;
+        jump.gravity = gravity;
+        jump.jumpStrength = jumpStrength;
+        jump.moveSpeed = moveSpeed;
+        jump.playerWidth = playerWidth;
+        jump.width = width;
+        return jump;
+    }
+
+    LevelParams levelParams() const {
+        LevelParams params;
+        params.width = width;
+        params.spacing = platformSpacing;
+        params.platformsPerChunk = platformsPerChunk;
+        params.jump = jumpModel();
+        return params;
+    }
+
+    void reset(uint64_t newSeed) {
+        seed = newSeed;
+        cameraY = 0.0f;
+        score = 0;
+        coinsCollected = 0;
+        gameOver = false;
+        deathCause = DeathCause::None;
+        events.discardPending();
+        ticks = 0;
+        narrowPhaseTests = 0;
+        totalNarrowPhaseTests = 0;
+        registry.clear();
+        platforms.clear();
+        collectibles.clear();
+        reserveLiveEntities();
+        spawnPlayer();
+        nextChunk = 0;
+        scoredY = levelParams().firstY + (initialPlatforms - 1) * platformSpacing;
+        // The opening screen is built here; the worker takes over from the
+        // first chunk past it.
+        streamChunks(nullptr);
+        if (streamer) streamer->restart(seed, levelParams(), nextChunk);
+    }
+
+    // Advances the simulation by one fixed tick, then delivers the tick's
+    // events. Does nothing once the player has fallen below the camera.
+    void step(const PlayerInput& input) {
+        if (gameOver) return;
+        PROFILE_PHASE(PHASE_PHYSICS);
+        ++ticks;
+
+        registry.get<Velocity>(player).x = input.moveDir * moveSpeed;
+        gravitySystem(registry);
+        movementSystem(registry, width);
+        landingSystem(registry, platforms, events);
+        narrowPhaseTests = pickupSystem(registry, collectibles);
+        totalNarrowPhaseTests += narrowPhaseTests;
+        pickupEffectSystem(registry, events, boostDuration);
+
+        // A copy: spawning below may grow the registry's arrays.
+        const Position p = playerPosition();
+        if (p.y > cameraY + height / 2.0f) {
+            cameraY = p.y - height / 2.0f;
+        }
+
+        generateNewPlatforms();
+        removeOldPlatforms();
+
+        if (p.y < cameraY - playerHeight) {
+            gameOver = true;
+            deathCause = playerJumper().lastLandingBroke ? DeathCause::BrokenPlatform : DeathCause::MissedJump;
+            events.push(EVENT_GAME_OVER, p.x, p.y, static_cast<int>(deathCause));
+        }
+
+        drainEvents();
+    }
+
+    const Position& playerPosition() const { return registry.get<Position>(player); }
+    const Velocity& playerVelocity() const { return registry.get<Velocity>(player); }
+    const Jumper& playerJumper() const { return registry.get<Jumper>(player); }
+
+    // Entities for the level, appended above everything already spawned of
+    // their kind (the views stay sorted by y). Chunks come in through these;
+    // tools that build a scene by hand can use them too.
+    void spawnPlatform(float x, float y, PlatformType type) {
+        Entity e = registry.create();
+        if (e == kNoEntity) return;
+        const PlatformTypeInfo& info = kPlatformTypes[type];
+        registry.add<Position>(e, x, y);
+        registry.add<Body>(e, info.width / 2, info.height / 2);
+        registry.add<PlatformComponent>(e, type, false);
+        if (type == PLATFORM_MOVING) {
+            registry.add<Velocity>(e, kPlatformSpeed, 0.0f);
+            registry.add<WallBounce>(e);
+        }
+        platforms.emplace_back(e);
+    }
+
+    template <typename T>
+    void spawnCollectible(float x, float y) {
+        Entity e = registry.create();
+        if (e == kNoEntity) return;
+        registry.add<Position>(e, x, y);
+        registry.add<Body>(e, T::size / 2, T::size / 2);
+        registry.add<Collectible>(e, true);
+        collectibles.of<T>().emplace_back(e);
+    }
+
+    // Destroys every platform and collectible; the player stays.
+    void clearLevel() {
+        const float everything = std::numeric_limits<float>::infinity();
+        cullingSystem(registry, platforms, everything);
+        collectibles.forEachType([&](auto, SortedView& items) { cullingSystem(registry, items, everything); });
+    }
+
+    // Most entities of one kind alive at once: everything between an item's
+    // height below the camera and the streaming line a spacing above the
+    // screen, plus a chunk streamed past that line. Coins and power-ups come
+    // at most one per platform (and one extra power-up in the first chunk).
+    size_t liveEntityBound() const {
+        float band = height + 2 * platformSpacing + levelParams().chunkHeight() + HighJumpPowerUp::size;
+        return static_cast<size_t>(band / platformSpacing) + 2;
+    }
+
+private:
+    // Sizes the registry and every view for liveEntityBound() of each kind
+    // plus the player, so spawning and retiring during play never touch the
+    // heap. Free after the first reset unless the window grew.
+    void reserveLiveEntities() {
+        size_t live = liveEntityBound();
+        registry.reserve(3 * live + 1);
+        platforms.reserve(live);
+        collectibles.reserve(live);
+    }
+
+    void spawnPlayer() {
+        player = registry.create();
+        registry.add<Position>(player, width / 2.0f, height / 5.0f);
+        registry.add<Velocity>(player, 0.0f, 0.0f);
+        registry.add<Gravity>(player, gravity);
+        registry.add<Body>(player, playerWidth / 2, playerHeight / 2);
+        registry.add<Wraps>(player);
+        registry.add<Jumper>(player, jumpStrength, boostedJumpStrength);
+        registry.add<PickupEffects>(player);
+    }
+
+    // The world is the first consumer of its own events: it keeps the score
+    // and coin count, then the subscribers see the same batch.
+    void drainEvents() {
+        for (const GameEvent& e : events) {
+            if (e.type == EVENT_SCORED) score += e.value;
+            else if (e.type == EVENT_COIN_COLLECTED) coinsCollected += e.value;
+        }
+        events.dispatch();
+    }
+
+    // Splices chunks in order until the band up to a spacing above the top
+    // of the screen is covered, the line the level used to be generated to
+    // one platform at a time. Chunks come from `source` when it has them
+    // ready and are generated inline otherwise; both give the same chunk.
+    void streamChunks(ChunkStreamer* source) {
+        LevelParams params = levelParams();
+        float line = cameraY + height + platformSpacing;
+        while (params.chunkBottom(nextChunk) - params.spacing < line) {
+            if (const LevelChunk* ready = source ? source->take(nextChunk) : nullptr) {
+                spliceChunk(*ready);
+                source->release();
+            }
+            else {
+                // Per thread, not per world, so snapshot copies of the world
+                // don't drag a scratch chunk along.
+                thread_local LevelChunk scratch;
+                generateChunk(params, seed, nextChunk, scratch);
+                spliceChunk(scratch);
+            }
+            ++nextChunk;
+        }
+    }
+
+    void spliceChunk(const LevelChunk& chunk) {
+        for (const ChunkPlatform& p : chunk.platforms) spawnPlatform(p.x, p.y, p.type);
+        for (const Coin& c : chunk.coins) spawnCollectible<Coin>(c.x, c.y);
+        const SortedView& powerUps = collectibles.of<HighJumpPowerUp>();
+        for (const HighJumpPowerUp& h : chunk.powerUps) {
+            // Chunks are built independently; keep the view sorted by y for
+            // the broadphase even when the spacing is tuned below the 20 px
+            // jitter.
+            float y = powerUps.empty() ? h.y : std::max(h.y, registry.get<Position>(powerUps.back()).y);
+            spawnCollectible<HighJumpPowerUp>(h.x, y);
+        }
+    }
+
+    // Streams chunks in, and scores 10 for each platform that comes within a
+    // spacing of the top of the screen, as when each one was generated there.
+    void generateNewPlatforms() {
+        PROFILE_PHASE(PHASE_GENERATE);
+        streamChunks(streamer);
+        int points = 0;
+        while (scoredY < cameraY + height + platformSpacing) {
+            scoredY += platformSpacing;
+            points += 10;
+        }
+        if (points) events.push(EVENT_SCORED, playerPosition().x, scoredY, points);
+    }
+
+    // Everything is generated in increasing y, so whatever has expired sits
+    // at the front of its view. Collected items were tombstoned (active =
+    // false) in place and are destroyed here once they reach the front.
+    void removeOldPlatforms() {
+        PROFILE_PHASE(PHASE_REMOVE);
+        cullingSystem(registry, platforms, cameraY);
+        collectibles.forEachType([&](auto, SortedView& items) { cullingSystem(registry, items, cameraY); });
+    }
+};
+
+// Simple policy used by headless runs: steer toward the highest intact
+// platform whose top is still below the peak of the current jump.
+inline PlayerInput chaseNextPlatform(const GameWorld& world) {
+    PlayerInput input;
+    const Position& player = world.playerPosition();
+    const float velY = world.playerVelocity().y;
+    float feet = player.y - world.playerHeight / 2;
+    float peak = feet;
+    if (velY > 0) {
+        // Same arc selection as generation, so the two agree on the physics.
+        JumpModel jump = world.jumpModel();
+        peak += withArc(jump, [&](auto arc) { return decltype(arc)::remainingRise(jump, velY); });
+    }
+    const GameRegistry& reg = world.registry;
+    const Position* target = nullptr;
+    for (size_t i = 0; i < world.platforms.size(); ++i) {
+        Entity e = world.platforms[i];
+        if (reg.get<PlatformComponent>(e).broken) continue;
+        const Position& p = reg.get<Position>(e);
+        if (p.y + reg.get<Body>(e).halfHeight > peak) break;
+        target = &p;
+    }
+    if (target) {
+        float dx = target->x - player.x;
+        // Going out one edge comes back in the other, so take the short way.
+        // The player wraps once fully off screen, a period of width plus its
+        // own width; measured against width alone, a target near the
+        // antipode flips sides at every wrap and the bot flickers across
+        // the edge forever.
+        float period = world.width + world.playerWidth;
+        if (dx > period / 2) dx -= period;
+        else if (dx < -period / 2) dx += period;
+        if (dx > world.moveSpeed) input.moveDir = 1;
+        else if (dx < -world.moveSpeed) input.moveDir = -1;
+    }
+    return input;
+}
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <GL/glut.h>
+#if defined(FREEGLUT)
+#include <GL/freeglut_ext.h>
+#endif
+#include <cstdlib>
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
+// GL entry points newer than 1.1 are not exported by every platform's
+// libGL (Windows stops at 1.1), so they are looked up at runtime through
+// freeglut. Everything here is null when the driver lacks them, and callers
+// fall back to a 1.1 path.
+
+#ifndef GL_ARRAY_BUFFER
+#define GL_ARRAY_BUFFER 0x8892
+#endif
+#ifndef GL_STREAM_DRAW
+#define GL_STREAM_DRAW 0x88E0
+#endif
+#ifndef GL_STATIC_DRAW
+#define GL_STATIC_DRAW 0x88E4
+#endif
+#ifndef GL_VERTEX_SHADER
+#define GL_VERTEX_SHADER 0x8B31
+#endif
+#ifndef GL_FRAGMENT_SHADER
+#define GL_FRAGMENT_SHADER 0x8B30
+#endif
+#ifndef GL_COMPILE_STATUS
+#define GL_COMPILE_STATUS 0x8B81
+#endif
+#ifndef GL_LINK_STATUS
+#define GL_LINK_STATUS 0x8B82
+#endif
+
+typedef ptrdiff_t GLsizeiptrCompat;
+typedef ptrdiff_t GLintptrCompat;
+
+struct GlFunctions {
+    void (APIENTRY *genBuffers)(GLsizei, GLuint*) = nullptr;
+    void (APIENTRY *deleteBuffers)(GLsizei, const GLuint*) = nullptr;
+    void (APIENTRY *bindBuffer)(GLenum, GLuint) = nullptr;
+    void (APIENTRY *bufferData)(GLenum, GLsizeiptrCompat, const void*, GLenum) = nullptr;
+    void (APIENTRY *bufferSubData)(GLenum, GLintptrCompat, GLsizeiptrCompat, const void*) = nullptr;
+
+    // GL 2.0 shaders.
+    GLuint (APIENTRY *createShader)(GLenum) = nullptr;
+    void (APIENTRY *deleteShader)(GLuint) = nullptr;
+    void (APIENTRY *shaderSource)(GLuint, GLsizei, const char* const*, const GLint*) = nullptr;
+    void (APIENTRY *compileShader)(GLuint) = nullptr;
+    void (APIENTRY *getShaderiv)(GLuint, GLenum, GLint*) = nullptr;
+    void (APIENTRY *getShaderInfoLog)(GLuint, GLsizei, GLsizei*, char*) = nullptr;
+    GLuint (APIENTRY *createProgram)() = nullptr;
+    void (APIENTRY *deleteProgram)(GLuint) = nullptr;
+    void (APIENTRY *attachShader)(GLuint, GLuint) = nullptr;
+    void (APIENTRY *bindAttribLocation)(GLuint, GLuint, const char*) = nullptr;
+    void (APIENTRY *linkProgram)(GLuint) = nullptr;
+    void (APIENTRY *getProgramiv)(GLuint, GLenum, GLint*) = nullptr;
+    void (APIENTRY *getProgramInfoLog)(GLuint, GLsizei, GLsizei*, char*) = nullptr;
+    void (APIENTRY *useProgram)(GLuint) = nullptr;
+    GLint (APIENTRY *getUniformLocation)(GLuint, const char*) = nullptr;
+    void (APIENTRY *uniform2fv)(GLint, GLsizei, const GLfloat*) = nullptr;
+    void (APIENTRY *uniform3fv)(GLint, GLsizei, const GLfloat*) = nullptr;
+    void (APIENTRY *uniform4f)(GLint, GLfloat, GLfloat, GLfloat, GLfloat) = nullptr;
+    void (APIENTRY *uniform4fv)(GLint, GLsizei, const GLfloat*) = nullptr;
+    void (APIENTRY *uniform1i)(GLint, GLint) = nullptr;
+    void (APIENTRY *enableVertexAttribArray)(GLuint) = nullptr;
+    void (APIENTRY *disableVertexAttribArray)(GLuint) = nullptr;
+    void (APIENTRY *vertexAttribPointer)(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*) = nullptr;
+
+    // GL 3.1 / 3.3 instancing.
+    void (APIENTRY *drawArraysInstanced)(GLenum, GLint, GLsizei, GLsizei) = nullptr;
+    void (APIENTRY *vertexAttribDivisor)(GLuint, GLuint) = nullptr;
+
+    // Window-system swap interval (GLX_MESA/SGI_swap_control or
+    // WGL_EXT_swap_control); all take the interval as their only argument.
+    int (APIENTRY *swapInterval)(int) = nullptr;
+
+    bool hasBuffers() const {
+        return genBuffers && deleteBuffers && bindBuffer && bufferData && bufferSubData;
+    }
+
+    bool hasShaders() const {
+        return createShader && deleteShader && shaderSource && compileShader && getShaderiv &&
+               getShaderInfoLog && createProgram && deleteProgram && attachShader &&
+               bindAttribLocation && linkProgram && getProgramiv && getProgramInfoLog &&
+               useProgram && getUniformLocation && uniform2fv && uniform3fv && uniform4f &&
+               uniform4fv && uniform1i &&
+               enableVertexAttribArray && disableVertexAttribArray && vertexAttribPointer;
+    }
+
+    bool hasInstancing() const {
+        return hasBuffers() && hasShaders() && drawArraysInstanced && vertexAttribDivisor;
+    }
+};
+
+// "major.minor" of the current context, e.g. 15 for 1.5, 0 without one.
+inline int glVersionNumber() {
+    const char* version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+    if (!version) return 0;
+    int major = std::atoi(version);
+    const char* dot = version;
+    while (*dot && *dot != '.') ++dot;
+    int minor = *dot ? std::atoi(dot + 1) : 0;
+    return major * 10 + minor;
+}
+
+template <typename Fn>
+inline void loadGlFunction(Fn& fn, const char* name) {
+#if defined(FREEGLUT)
+    fn = reinterpret_cast<Fn>(glutGetProcAddress(name));
+#else
+    (void)name;
+    fn = nullptr;
+#endif
+}
+
+// Must be called with a current context.
+inline GlFunctions& glFunctions() {
+    static GlFunctions fns;
+    static bool loaded = false;
+    if (!loaded) {
+        loaded = true;
+        if (glVersionNumber() >= 15) {
+            loadGlFunction(fns.genBuffers, "glGenBuffers");
+            loadGlFunction(fns.deleteBuffers, "glDeleteBuffers");
+            loadGlFunction(fns.bindBuffer, "glBindBuffer");
+            loadGlFunction(fns.bufferData, "glBufferData");
+            loadGlFunction(fns.bufferSubData, "glBufferSubData");
+        }
+        if (glVersionNumber() >= 20) {
+            loadGlFunction(fns.createShader, "glCreateShader");
+            loadGlFunction(fns.deleteShader, "glDeleteShader");
+            loadGlFunction(fns.shaderSource, "glShaderSource");
+            loadGlFunction(fns.compileShader, "glCompileShader");
+            loadGlFunction(fns.getShaderiv, "glGetShaderiv");
+            loadGlFunction(fns.getShaderInfoLog, "glGetShaderInfoLog");
+            loadGlFunction(fns.createProgram, "glCreateProgram");
+            loadGlFunction(fns.deleteProgram, "glDeleteProgram");
+            loadGlFunction(fns.attachShader, "glAttachShader");
+            loadGlFunction(fns.bindAttribLocation, "glBindAttribLocation");
+            loadGlFunction(fns.linkProgram, "glLinkProgram");
+            loadGlFunction(fns.getProgramiv, "glGetProgramiv");
+            loadGlFunction(fns.getProgramInfoLog, "glGetProgramInfoLog");
+            loadGlFunction(fns.useProgram, "glUseProgram");
+            loadGlFunction(fns.getUniformLocation, "glGetUniformLocation");
+            loadGlFunction(fns.uniform2fv, "glUniform2fv");
+            loadGlFunction(fns.uniform3fv, "glUniform3fv");
+            loadGlFunction(fns.uniform4f, "glUniform4f");
+            loadGlFunction(fns.uniform4fv, "glUniform4fv");
+            loadGlFunction(fns.uniform1i, "glUniform1i");
+            loadGlFunction(fns.enableVertexAttribArray, "glEnableVertexAttribArray");
+            loadGlFunction(fns.disableVertexAttribArray, "glDisableVertexAttribArray");
+            loadGlFunction(fns.vertexAttribPointer, "glVertexAttribPointer");
+        }
+        if (glVersionNumber() >= 33) {
+            loadGlFunction(fns.drawArraysInstanced, "glDrawArraysInstanced");
+            loadGlFunction(fns.vertexAttribDivisor, "glVertexAttribDivisor");
+        }
+        loadGlFunction(fns.swapInterval, "glXSwapIntervalMESA");
+        if (!fns.swapInterval) loadGlFunction(fns.swapInterval, "glXSwapIntervalSGI");
+        if (!fns.swapInterval) loadGlFunction(fns.swapInterval, "wglSwapIntervalEXT");
+    }
+    return fns;
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "sprite_batch.h"
+#include "texture_atlas.h"
+
+// Fixed-capacity text that never allocates. Integers are formatted with
+// std::to_chars straight into the buffer; anything past the capacity is
+// dropped.
+template <size_t N>
+class TextBuffer {
+public:
+    TextBuffer& clear() {
+        length = 0;
+        text[0] = '\0';
+        return *this;
+    }
+
+    TextBuffer& append(const char* s) {
+        while (*s && length < N - 1) text[length++] = *s++;
+        text[length] = '\0';
+        return *this;
+    }
+
+    TextBuffer& append(long long value) {
+        std::to_chars_result r = std::to_chars(text + length, text + N - 1, value);
+        if (r.ec == std::errc()) length = static_cast<size_t>(r.ptr - text);
+        text[length] = '\0';
+        return *this;
+    }
+
+    // Non-negative `value` rounded to `decimals` places, e.g. 12.5.
+    TextBuffer& appendFixed(double value, int decimals) {
+        long long scale = 1;
+        for (int i = 0; i < decimals; ++i) scale *= 10;
+        long long scaled = static_cast<long long>(value * scale + 0.5);
+        append(scaled / scale);
+        if (decimals > 0) {
+            char digits[20];
+            long long frac = scaled % scale;
+            for (int i = decimals - 1; i >= 0; --i, frac /= 10) digits[i] = static_cast<char>('0' + frac % 10);
+            digits[decimals] = '\0';
+            append(".").append(digits);
+        }
+        return *this;
+    }
+
+    const char* c_str() const { return text; }
+    size_t size() const { return length; }
+
+private:
+    char text[N] = {};
+    size_t length = 0;
+};
+
+// Printable ASCII in a classic 5x7 cell: five column bytes per glyph, bit 0
+// at the top.
+constexpr int kGlyphFirst = 32;
+constexpr int kGlyphCount = 95;
+constexpr int kGlyphColumns = 5;
+constexpr int kGlyphRows = 7;
+
+constexpr uint8_t kGlyphBits[kGlyphCount][kGlyphColumns] = {
+    { 0x00, 0x00, 0x00, 0x00, 0x00 }, { 0x00, 0x00, 0x5F, 0x00, 0x00 }, // ' ' !
+    { 0x00, 0x07, 0x00, 0x07, 0x00 }, { 0x14, 0x7F, 0x14, 0x7F, 0x14 }, // " #
+    { 0x24, 0x2A, 0x7F, 0x2A, 0x12 }, { 0x23, 0x13, 0x08, 0x64, 0x62 }, // $ %
+    { 0x36, 0x49, 0x56, 0x20, 0x50 }, { 0x00, 0x00, 0x07, 0x00, 0x00 }, // & '
+    { 0x00, 0x1C, 0x22, 0x41, 0x00 }, { 0x00, 0x41, 0x22, 0x1C, 0x00 }, // ( )
+    { 0x14, 0x08, 0x3E, 0x08, 0x14 }, { 0x08, 0x08, 0x3E, 0x08, 0x08 }, // * +
+    { 0x00, 0x50, 0x30, 0x00, 0x00 }, { 0x08, 0x08, 0x08, 0x08, 0x08 }, // , -
+    { 0x00, 0x60, 0x60, 0x00, 0x00 }, { 0x20, 0x10, 0x08, 0x04, 0x02 }, // . /
+    { 0x3E, 0x51, 0x49, 0x45, 0x3E }, { 0x00, 0x42, 0x7F, 0x40, 0x00 }, // 0 1
+    { 0x42, 0x61, 0x51, 0x49, 0x46 }, { 0x21, 0x41, 0x45, 0x4B, 0x31 }, // 2 3
+    { 0x18, 0x14, 0x12, 0x7F, 0x10 }, { 0x27, 0x45, 0x45, 0x45, 0x39 }, // 4 5
+    { 0x3C, 0x4A, 0x49, 0x49, 0x30 }, { 0x01, 0x71, 0x09, 0x05, 0x03 }, // 6 7
+    { 0x36, 0x49, 0x49, 0x49, 0x36 }, { 0x06, 0x49, 0x49, 0x29, 0x1E }, // 8 9
+    { 0x00, 0x36, 0x36, 0x00, 0x00 }, { 0x00, 0x56, 0x36, 0x00, 0x00 }, // : ;
+    { 0x08, 0x14, 0x22, 0x41, 0x00 }, { 0x14, 0x14, 0x14, 0x14, 0x14 }, // < =
+    { 0x00, 0x41, 0x22, 0x14, 0x08 }, { 0x02, 0x01, 0x51, 0x09, 0x06 }, // > ?
+    { 0x32, 0x49, 0x79, 0x41, 0x3E }, { 0x7E, 0x11, 0x11, 0x11, 0x7E }, // @ A
+    { 0x7F, 0x49, 0x49, 0x49, 0x36 }, { 0x3E, 0x41, 0x41, 0x41, 0x22 }, // B C
+    { 0x7F, 0x41, 0x41, 0x22, 0x1C }, { 0x7F, 0x49, 0x49, 0x49, 0x41 }, // D E
+    { 0x7F, 0x09, 0x09, 0x09, 0x01 }, { 0x3E, 0x41, 0x49, 0x49, 0x7A }, // F G
+    { 0x7F, 0x08, 0x08, 0x08, 0x7F }, { 0x00, 0x41, 0x7F, 0x41, 0x00 }, // H I
+    { 0x20, 0x40, 0x41, 0x3F, 0x01 }, { 0x7F, 0x08, 0x14, 0x22, 0x41 }, // J K
+    { 0x7F, 0x40, 0x40, 0x40, 0x40 }, { 0x7F, 0x02, 0x0C, 0x02, 0x7F }, // L M
+    { 0x7F, 0x04, 0x08, 0x10, 0x7F }, { 0x3E, 0x41, 0x41, 0x41, 0x3E }, // N O
+    { 0x7F, 0x09, 0x09, 0x09, 0x06 }, { 0x3E, 0x41, 0x51, 0x21, 0x5E }, // P Q
+    { 0x7F, 0x09, 0x19, 0x29, 0x46 }, { 0x46, 0x49, 0x49, 0x49, 0x31 }, // R S
+    { 0x01, 0x01, 0x7F, 0x01, 0x01 }, { 0x3F, 0x40, 0x40, 0x40, 0x3F }, // T U
+    { 0x1F, 0x20, 0x40, 0x20, 0x1F }, { 0x3F, 0x40, 0x38, 0x40, 0x3F }, // V W
+    { 0x63, 0x14, 0x08, 0x14, 0x63 }, { 0x07, 0x08, 0x70, 0x08, 0x07 }, // X Y
+    { 0x61, 0x51, 0x49, 0x45, 0x43 }, { 0x00, 0x7F, 0x41, 0x41, 0x00 }, // Z [
+    { 0x02, 0x04, 0x08, 0x10, 0x20 }, { 0x00, 0x41, 0x41, 0x7F, 0x00 }, // \ ]
+    { 0x04, 0x02, 0x01, 0x02, 0x04 }, { 0x40, 0x40, 0x40, 0x40, 0x40 }, // ^ _
+    { 0x00, 0x01, 0x02, 0x04, 0x00 }, { 0x20, 0x54, 0x54, 0x54, 0x78 }, // ` a
+    { 0x7F, 0x48, 0x44, 0x44, 0x38 }, { 0x38, 0x44, 0x44, 0x44, 0x20 }, // b c
+    { 0x38, 0x44, 0x44, 0x48, 0x7F }, { 0x38, 0x54, 0x54, 0x54, 0x18 }, // d e
+    { 0x08, 0x7E, 0x09, 0x01, 0x02 }, { 0x0C, 0x52, 0x52, 0x52, 0x3E }, // f g
+    { 0x7F, 0x08, 0x04, 0x04, 0x78 }, { 0x00, 0x44, 0x7D, 0x40, 0x00 }, // h i
+    { 0x20, 0x40, 0x44, 0x3D, 0x00 }, { 0x7F, 0x10, 0x28, 0x44, 0x00 }, // j k
+    { 0x00, 0x41, 0x7F, 0x40, 0x00 }, { 0x7C, 0x04, 0x18, 0x04, 0x78 }, // l m
+    { 0x7C, 0x08, 0x04, 0x04, 0x78 }, { 0x38, 0x44, 0x44, 0x44, 0x38 }, // n o
+    { 0x7C, 0x14, 0x14, 0x14, 0x08 }, { 0x08, 0x14, 0x14, 0x18, 0x7C }, // p q
+    { 0x7C, 0x08, 0x04, 0x04, 0x08 }, { 0x48, 0x54, 0x54, 0x54, 0x20 }, // r s
+    { 0x04, 0x3F, 0x44, 0x40, 0x20 }, { 0x3C, 0x40, 0x40, 0x20, 0x7C }, // t u
+    { 0x1C, 0x20, 0x40, 0x20, 0x1C }, { 0x3C, 0x40, 0x30, 0x40, 0x3C }, // v w
+    { 0x44, 0x28, 0x10, 0x28, 0x44 }, { 0x0C, 0x50, 0x50, 0x50, 0x3C }, // x y
+    { 0x44, 0x64, 0x54, 0x4C, 0x44 }, { 0x00, 0x08, 0x36, 0x41, 0x00 }, // z {
+    { 0x00, 0x00, 0x7F, 0x00, 0x00 }, { 0x00, 0x41, 0x36, 0x08, 0x00 }, // | }
+    { 0x08, 0x04, 0x08, 0x10, 0x08 },                                   // ~
+};
+
+// The 5x7 font rasterized into the shared atlas at an integer scale. Quads
+// are placed on whole pixels at 1:1 with their texels, so linear filtering
+// still gives crisp edges.
+class BitmapFont {
+public:
+    static constexpr int kScale = 2;
+    static constexpr int kGlyphWidth = kGlyphColumns * kScale;
+    static constexpr int kGlyphHeight = kGlyphRows * kScale;
+    static constexpr int kAdvance = kGlyphWidth + kScale;
+
+    // Call before atlas.pack().
+    static void addGlyphs(TextureAtlas& atlas) {
+        unsigned char pixels[kGlyphWidth * kGlyphHeight * 4];
+        for (int g = 0; g < kGlyphCount; ++g) {
+            for (int y = 0; y < kGlyphHeight; ++y) {
+                for (int x = 0; x < kGlyphWidth; ++x) {
+                    bool on = (kGlyphBits[g][x / kScale] >> (y / kScale)) & 1;
+                    unsigned char* p = pixels + (y * kGlyphWidth + x) * 4;
+                    p[0] = p[1] = p[2] = 255;
+                    p[3] = on ? 255 : 0;
+                }
+            }
+            atlas.addPixels(glyphName(g), kGlyphWidth, kGlyphHeight, pixels);
+        }
+    }
+
+    // Call after atlas.pack().
+    void bind(const TextureAtlas& atlas) {
+        for (int g = 0; g < kGlyphCount; ++g) glyphs[g] = *atlas.find(glyphName(g));
+    }
+
+    static float textWidth(const char* text) {
+        return static_cast<float>(std::strlen(text) * kAdvance);
+    }
+
+    // Appends one quad per visible glyph with the baseline at y.
+    void addText(SpriteBatch& batch, float x, float y, const char* text, const Color& color) const {
+        float penX = static_cast<float>(static_cast<int>(x));
+        float baseY = static_cast<float>(static_cast<int>(y));
+        for (; *text; ++text, penX += kAdvance) {
+            int g = static_cast<unsigned char>(*text) - kGlyphFirst;
+            if (g <= 0 || g >= kGlyphCount) continue; // space, or not in the font
+            batch.addSprite(penX + kGlyphWidth / 2.0f, baseY + kGlyphHeight / 2.0f,
+                            kGlyphWidth, kGlyphHeight, glyphs[g], color);
+        }
+    }
+
+private:
+    static std::string glyphName(int g) {
+        return "glyph:" + std::to_string(g + kGlyphFirst);
+    }
+
+    UvRect glyphs[kGlyphCount] = {};
+};
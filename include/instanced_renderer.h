@@ -0,0 +1,222 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "gl_loader.h"
+#include "platform_store.h"
+#include "sprite_batch.h"
+
+// Every kind of quad the game draws. Platform kinds share PlatformType's
+// numbering so a platform's flag byte maps straight to its kind.
+enum QuadKind {
+    QUAD_COIN = PLATFORM_TYPE_COUNT,
+    QUAD_POWER_UP,
+    QUAD_PLAYER,
+    QUAD_KIND_COUNT
+};
+
+// 12 bytes per quad: center and kind. Size, color and atlas rect come from
+// the per-kind uniform table, so nothing per-vertex is sent.
+struct QuadInstance {
+    float x, y;
+    float kind;
+};
+
+// Draws all quads of a frame with one glDrawArraysInstanced over a static
+// 4-vertex unit quad and a streamed per-instance buffer. Needs GL 3.3 (or
+// 3.1 plus ARB_instanced_arrays, which exposes the same entry points);
+// init() returns false when the context can't do it and callers fall back
+// to SpriteBatch.
+class InstancedRenderer {
+public:
+    // Deletes the GL objects while the context that made them is current.
+    // Not done from a destructor: globals outlive the context, and headless
+    // runs never create one, so this returns early when init() made nothing.
+    void release() {
+        if (!program && !cornerVbo && !instanceVbo) return;
+        GlFunctions& gl = glFunctions();
+        if (program) gl.deleteProgram(program);
+        if (cornerVbo) gl.deleteBuffers(1, &cornerVbo);
+        if (instanceVbo) gl.deleteBuffers(1, &instanceVbo);
+        program = cornerVbo = instanceVbo = 0;
+    }
+
+    bool init() {
+        GlFunctions& gl = glFunctions();
+        if (!gl.hasInstancing()) return false;
+
+        GLuint vs = compile(GL_VERTEX_SHADER, vertexSource().c_str());
+        GLuint fs = compile(GL_FRAGMENT_SHADER, kFragmentSource);
+        if (!vs || !fs) return false;
+
+        program = gl.createProgram();
+        gl.attachShader(program, vs);
+        gl.attachShader(program, fs);
+        gl.bindAttribLocation(program, kCornerAttrib, "corner");
+        gl.bindAttribLocation(program, kInstanceAttrib, "instance");
+        gl.linkProgram(program);
+        gl.deleteShader(vs);
+        gl.deleteShader(fs);
+
+        GLint linked = 0;
+        gl.getProgramiv(program, GL_LINK_STATUS, &linked);
+        if (!linked) {
+            char log[1024];
+            gl.getProgramInfoLog(program, sizeof(log), nullptr, log);
+            std::cerr << "instanced renderer: link failed: " << log << std::endl;
+            gl.deleteProgram(program);
+            program = 0;
+            return false;
+        }
+
+        sizeLocation = gl.getUniformLocation(program, "kindSize");
+        colorLocation = gl.getUniformLocation(program, "kindColor");
+        viewLocation = gl.getUniformLocation(program, "view");
+        uvLocation = gl.getUniformLocation(program, "kindUv");
+        atlasLocation = gl.getUniformLocation(program, "atlas");
+
+        static const float corners[8] = { -0.5f, -0.5f, 0.5f, -0.5f, -0.5f, 0.5f, 0.5f, 0.5f };
+        gl.genBuffers(1, &cornerVbo);
+        gl.bindBuffer(GL_ARRAY_BUFFER, cornerVbo);
+        gl.bufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+        gl.genBuffers(1, &instanceVbo);
+        gl.bindBuffer(GL_ARRAY_BUFFER, 0);
+        return true;
+    }
+
+    bool ready() const { return program != 0; }
+
+    // Every kind samples the atlas; flat kinds point at its white block.
+    void setAtlas(GLuint atlasTexture) { texture = atlasTexture; }
+
+    void setKind(int kind, float width, float height, const Color& color, const UvRect& uv) {
+        sizes[kind * 2] = width;
+        sizes[kind * 2 + 1] = height;
+        colors[kind * 3] = color.r;
+        colors[kind * 3 + 1] = color.g;
+        colors[kind * 3 + 2] = color.b;
+        uvs[kind * 4] = uv.u0;
+        uvs[kind * 4 + 1] = uv.v0;
+        uvs[kind * 4 + 2] = uv.u1;
+        uvs[kind * 4 + 3] = uv.v1;
+    }
+
+    void begin() { instances.clear(); }
+
+    void add(float x, float y, int kind) {
+        instances.push_back({ x, y, static_cast<float>(kind) });
+    }
+
+    size_t quadCount() const { return instances.size(); }
+
+    // Draws everything added since begin() in world coordinates, with the
+    // bottom of a viewWidth x viewHeight view at cameraY.
+    void flush(float cameraY, int viewWidth, int viewHeight) {
+        if (instances.empty()) return;
+        GlFunctions& gl = glFunctions();
+
+        gl.useProgram(program);
+        gl.uniform2fv(sizeLocation, QUAD_KIND_COUNT, sizes);
+        gl.uniform3fv(colorLocation, QUAD_KIND_COUNT, colors);
+        gl.uniform4f(viewLocation, 2.0f / viewWidth, 2.0f / viewHeight, cameraY, 0.0f);
+        gl.uniform4fv(uvLocation, QUAD_KIND_COUNT, uvs);
+        gl.uniform1i(atlasLocation, 0);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+        gl.bindBuffer(GL_ARRAY_BUFFER, cornerVbo);
+        gl.enableVertexAttribArray(kCornerAttrib);
+        gl.vertexAttribPointer(kCornerAttrib, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+
+        GLsizeiptrCompat bytes = static_cast<GLsizeiptrCompat>(instances.size() * sizeof(QuadInstance));
+        if (bytes > instanceBytes) instanceBytes = bytes;
+        gl.bindBuffer(GL_ARRAY_BUFFER, instanceVbo);
+        gl.bufferData(GL_ARRAY_BUFFER, instanceBytes, nullptr, GL_STREAM_DRAW);
+        gl.bufferSubData(GL_ARRAY_BUFFER, 0, bytes, instances.data());
+        gl.enableVertexAttribArray(kInstanceAttrib);
+        gl.vertexAttribPointer(kInstanceAttrib, 3, GL_FLOAT, GL_FALSE, sizeof(QuadInstance), nullptr);
+        gl.vertexAttribDivisor(kInstanceAttrib, 1);
+
+        gl.drawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(instances.size()));
+
+        gl.vertexAttribDivisor(kInstanceAttrib, 0);
+        gl.disableVertexAttribArray(kInstanceAttrib);
+        gl.disableVertexAttribArray(kCornerAttrib);
+        gl.bindBuffer(GL_ARRAY_BUFFER, 0);
+        gl.useProgram(0);
+        glDisable(GL_BLEND);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        drawCalls++;
+    }
+
+    long long drawCalls = 0;
+
+private:
+    static constexpr GLuint kCornerAttrib = 0;
+    static constexpr GLuint kInstanceAttrib = 1;
+
+    static std::string vertexSource() {
+        std::string n = std::to_string(QUAD_KIND_COUNT);
+        return "#version 130\n"
+               "in vec2 corner;\n"
+               "in vec3 instance;\n"
+               "uniform vec2 kindSize[" + n + "];\n"
+               "uniform vec3 kindColor[" + n + "];\n"
+               "uniform vec4 kindUv[" + n + "];\n"
+               "uniform vec4 view;\n"
+               "out vec3 color;\n"
+               "out vec2 uv;\n"
+               "void main() {\n"
+               "    int kind = int(instance.z);\n"
+               "    vec2 pos = instance.xy + corner * kindSize[kind];\n"
+               "    gl_Position = vec4(pos.x * view.x - 1.0, (pos.y - view.z) * view.y - 1.0, 0.0, 1.0);\n"
+               "    color = kindColor[kind];\n"
+               "    vec4 rect = kindUv[kind];\n"
+               "    uv = vec2(mix(rect.x, rect.z, corner.x + 0.5), mix(rect.w, rect.y, corner.y + 0.5));\n"
+               "}\n";
+    }
+
+    static constexpr const char* kFragmentSource =
+        "#version 130\n"
+        "uniform sampler2D atlas;\n"
+        "in vec3 color;\n"
+        "in vec2 uv;\n"
+        "void main() {\n"
+        "    gl_FragColor = texture(atlas, uv) * vec4(color, 1.0);\n"
+        "}\n";
+
+    static GLuint compile(GLenum stage, const char* source) {
+        GlFunctions& gl = glFunctions();
+        GLuint shader = gl.createShader(stage);
+        gl.shaderSource(shader, 1, &source, nullptr);
+        gl.compileShader(shader);
+        GLint compiled = 0;
+        gl.getShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+        if (!compiled) {
+            char log[1024];
+            gl.getShaderInfoLog(shader, sizeof(log), nullptr, log);
+            std::cerr << "instanced renderer: shader compile failed: " << log << std::endl;
+            gl.deleteShader(shader);
+            return 0;
+        }
+        return shader;
+    }
+
+    GLuint program = 0;
+    GLuint cornerVbo = 0;
+    GLuint instanceVbo = 0;
+    GLint sizeLocation = -1;
+    GLint colorLocation = -1;
+    GLint viewLocation = -1;
+    GLint uvLocation = -1;
+    GLint atlasLocation = -1;
+    GLuint texture = 0;
+    GLsizeiptrCompat instanceBytes = 0;
+    float sizes[QUAD_KIND_COUNT * 2] = {};
+    float colors[QUAD_KIND_COUNT * 3] = {};
+    float uvs[QUAD_KIND_COUNT * 4] = {};
+    std::vector<QuadInstance> instances;
+};
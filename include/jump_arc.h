@@ -0,0 +1,104 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+// Physics profiles: the constants a level is tuned for. GameWorld starts
+// from DefaultPhysics; the farm and validator can still sweep the values at
+// run time, and then fall back to the closed form in JumpModel (withArc in
+// reachability.h picks one or the other).
+struct DefaultPhysics {
+    static constexpr float gravity = 0.3f;
+    static constexpr float jumpStrength = 10.0f;
+    static constexpr float boostedJumpStrength = 18.0f;
+    static constexpr float moveSpeed = 4.0f;
+};
+
+// Feet above the launch top t ticks after bouncing at v0: the same float
+// expression as JumpModel::heightAt, so tables built from it agree with the
+// closed form and with the simulation tick for tick.
+constexpr float arcHeight(float v0, float gravity, int t) {
+    return v0 * t - gravity * t * (t + 1) / 2;
+}
+
+constexpr int arcApexTick(float v0, float gravity) {
+    int t = 0;
+    while (arcHeight(v0, gravity, t + 1) > arcHeight(v0, gravity, t)) ++t;
+    return t;
+}
+
+// Ticks until the feet are back below the launch top.
+constexpr int arcAirTicks(float v0, float gravity) {
+    int t = 1;
+    while (arcHeight(v0, gravity, t) >= 0) ++t;
+    return t;
+}
+
+template <size_t N>
+constexpr std::array<float, N> arcHeightTable(float v0, float gravity) {
+    std::array<float, N> h = {};
+    for (size_t t = 0; t < N; ++t) h[t] = arcHeight(v0, gravity, static_cast<int>(t));
+    return h;
+}
+
+// Entry dy: moveSpeed times one tick short of the tick the player lands on a
+// top dy pixels up, as JumpModel::reach. Scans down from airTicks for the
+// last tick still at or above dy.
+template <size_t N>
+constexpr std::array<float, N> arcReachTable(float v0, float gravity, float moveSpeed, int airTicks) {
+    std::array<float, N> r = {};
+    int last = airTicks;
+    for (size_t dy = 0; dy < N; ++dy) {
+        while (arcHeight(v0, gravity, last) < static_cast<float>(dy)) --last;
+        r[dy] = moveSpeed * last;
+    }
+    return r;
+}
+
+// One profile's jump arc sampled per tick, built by the compiler and
+// selected by the profile type.
+template <typename Profile>
+struct JumpArc {
+    static constexpr int kApexTick = arcApexTick(Profile::jumpStrength, Profile::gravity);
+    static constexpr float kApexHeight = arcHeight(Profile::jumpStrength, Profile::gravity, kApexTick);
+    static constexpr int kAirTicks = arcAirTicks(Profile::jumpStrength, Profile::gravity);
+    // Highest whole number of pixels the arc clears.
+    static constexpr int kMaxRise = static_cast<int>(kApexHeight);
+
+    using HeightTable = std::array<float, kAirTicks + 1>;
+    using ReachTable = std::array<float, kMaxRise + 1>;
+
+    // height[t]: feet above the launch top t ticks after the bounce.
+    static constexpr HeightTable height = arcHeightTable<kAirTicks + 1>(Profile::jumpStrength, Profile::gravity);
+    // reach[dy]: horizontal travel before landing on a top dy pixels up.
+    static constexpr ReachTable reach =
+        arcReachTable<kMaxRise + 1>(Profile::jumpStrength, Profile::gravity, Profile::moveSpeed, kAirTicks);
+
+    // Horizontal reach to land on a top dy up, or -1 if the arc can't get
+    // there. A fractional dy rounds up, which never overstates the reach.
+    static constexpr float reachFor(float dy) {
+        if (dy <= 0) return reach[0];
+        int row = static_cast<int>(dy);
+        if (row < dy) ++row;
+        return row > kMaxRise ? -1.0f : reach[row];
+    }
+
+    // Rise still to come for a player moving up at v on this arc, read off
+    // the tick that speed puts them at. -1 when v isn't one of the arc's
+    // speeds (a boosted jump), for the caller to fall back on v^2 / 2g.
+    static constexpr float remainingRise(float v) {
+        float t = (Profile::jumpStrength - v) / Profile::gravity;
+        int tick = static_cast<int>(t + 0.5f);
+        float off = t - tick;
+        if (t < -0.5f || tick > kApexTick || off > 0.01f || off < -0.01f) return -1.0f;
+        return kApexHeight - height[tick];
+    }
+};
+
+template <typename Profile> constexpr typename JumpArc<Profile>::HeightTable JumpArc<Profile>::height;
+template <typename Profile> constexpr typename JumpArc<Profile>::ReachTable JumpArc<Profile>::reach;
+
+static_assert(JumpArc<DefaultPhysics>::kApexTick == 33, "default jump peaks 33 ticks after the bounce");
+static_assert(JumpArc<DefaultPhysics>::reachFor(80.0f) == 224.0f, "one default spacing up leaves 56 ticks of travel");
+static_assert(JumpArc<DefaultPhysics>::remainingRise(DefaultPhysics::jumpStrength) == JumpArc<DefaultPhysics>::kApexHeight,
+              "a fresh bounce has the whole arc ahead");
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define LANDING_KERNEL_AVX2 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LANDING_KERNEL_SSE2 1
+#endif
+
+#include "platform_store.h"
+
+// Swept landing test over PlatformStore arrays: the first intact platform the
+// player's bottom edge crossed this tick while overlapping it horizontally.
+// The vector versions evaluate the same float expressions lane by lane with
+// ordered compares, so they pick the same platform as the scalar loop,
+// including for NaN inputs.
+
+// The vector paths broadcast one width and height for every lane.
+static_assert(kPlatformTypes[PLATFORM_NORMAL].width == kPlatformTypes[PLATFORM_MOVING].width &&
+              kPlatformTypes[PLATFORM_NORMAL].width == kPlatformTypes[PLATFORM_BREAKABLE].width &&
+              kPlatformTypes[PLATFORM_NORMAL].height == kPlatformTypes[PLATFORM_MOVING].height &&
+              kPlatformTypes[PLATFORM_NORMAL].height == kPlatformTypes[PLATFORM_BREAKABLE].height,
+              "landing kernel assumes one platform size; add a per-type gather before varying it");
+
+struct LandingQuery {
+    float playerLeft;
+    float playerRight;
+    float bottomPrevious;
+    float bottomCurrent;
+};
+
+inline int findLandingScalar(const float* x, const float* y, const uint8_t* flags,
+                             int begin, int end, const LandingQuery& q) {
+    for (int i = begin; i < end; ++i) {
+        const PlatformTypeInfo& info = kPlatformTypes[flags[i] & PLATFORM_TYPE_MASK];
+        float top = y[i] + info.height / 2;
+        bool hit = !(flags[i] & PLATFORM_BROKEN) &
+                   (q.playerRight > x[i] - info.width / 2) &
+                   (q.playerLeft < x[i] + info.width / 2) &
+                   (q.bottomPrevious >= top) &
+                   (q.bottomCurrent < top);
+        if (hit) return i;
+    }
+    return -1;
+}
+
+inline int lowestSetBit(unsigned mask) {
+#if defined(__GNUC__)
+    return __builtin_ctz(mask);
+#else
+    int bit = 0;
+    while (!(mask & 1u)) { mask >>= 1; ++bit; }
+    return bit;
+#endif
+}
+
+#if LANDING_KERNEL_SSE2
+// Lanes of four: flags widen from bytes to 32-bit lanes with two unpacks.
+inline unsigned landingMaskSse2(const float* x, const float* y, const uint8_t* flags,
+                                const LandingQuery& q) {
+    const __m128 halfWidth = _mm_set1_ps(kPlatformTypes[PLATFORM_NORMAL].width / 2);
+    const __m128 halfHeight = _mm_set1_ps(kPlatformTypes[PLATFORM_NORMAL].height / 2);
+    const __m128i zero = _mm_setzero_si128();
+
+    __m128 px = _mm_loadu_ps(x);
+    __m128 top = _mm_add_ps(_mm_loadu_ps(y), halfHeight);
+
+    int32_t packed;
+    std::memcpy(&packed, flags, sizeof(packed));
+    __m128i f = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), zero), zero);
+    __m128i intact = _mm_cmpeq_epi32(_mm_and_si128(f, _mm_set1_epi32(PLATFORM_BROKEN)), zero);
+
+    __m128 hit = _mm_castsi128_ps(intact);
+    hit = _mm_and_ps(hit, _mm_cmpgt_ps(_mm_set1_ps(q.playerRight), _mm_sub_ps(px, halfWidth)));
+    hit = _mm_and_ps(hit, _mm_cmplt_ps(_mm_set1_ps(q.playerLeft), _mm_add_ps(px, halfWidth)));
+    hit = _mm_and_ps(hit, _mm_cmpge_ps(_mm_set1_ps(q.bottomPrevious), top));
+    hit = _mm_and_ps(hit, _mm_cmplt_ps(_mm_set1_ps(q.bottomCurrent), top));
+    return static_cast<unsigned>(_mm_movemask_ps(hit));
+}
+
+inline int findLandingSse2(const float* x, const float* y, const uint8_t* flags,
+                           int begin, int end, const LandingQuery& q) {
+    int i = begin;
+    for (; i + 8 <= end; i += 8) {
+        unsigned mask = landingMaskSse2(x + i, y + i, flags + i, q) |
+                        landingMaskSse2(x + i + 4, y + i + 4, flags + i + 4, q) << 4;
+        if (mask) return i + lowestSetBit(mask);
+    }
+    return findLandingScalar(x, y, flags, i, end, q);
+}
+#endif
+
+#if LANDING_KERNEL_AVX2
+inline int findLandingAvx2(const float* x, const float* y, const uint8_t* flags,
+                           int begin, int end, const LandingQuery& q) {
+    const __m256 halfWidth = _mm256_set1_ps(kPlatformTypes[PLATFORM_NORMAL].width / 2);
+    const __m256 halfHeight = _mm256_set1_ps(kPlatformTypes[PLATFORM_NORMAL].height / 2);
+    const __m256 right = _mm256_set1_ps(q.playerRight);
+    const __m256 left = _mm256_set1_ps(q.playerLeft);
+    const __m256 previous = _mm256_set1_ps(q.bottomPrevious);
+    const __m256 current = _mm256_set1_ps(q.bottomCurrent);
+    const __m256i broken = _mm256_set1_epi32(PLATFORM_BROKEN);
+
+    int i = begin;
+    for (; i + 8 <= end; i += 8) {
+        __m256 px = _mm256_loadu_ps(x + i);
+        __m256 top = _mm256_add_ps(_mm256_loadu_ps(y + i), halfHeight);
+        __m256i f = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(flags + i)));
+        __m256i intact = _mm256_cmpeq_epi32(_mm256_and_si256(f, broken), _mm256_setzero_si256());
+
+        __m256 hit = _mm256_castsi256_ps(intact);
+        hit = _mm256_and_ps(hit, _mm256_cmp_ps(right, _mm256_sub_ps(px, halfWidth), _CMP_GT_OQ));
+        hit = _mm256_and_ps(hit, _mm256_cmp_ps(left, _mm256_add_ps(px, halfWidth), _CMP_LT_OQ));
+        hit = _mm256_and_ps(hit, _mm256_cmp_ps(previous, top, _CMP_GE_OQ));
+        hit = _mm256_and_ps(hit, _mm256_cmp_ps(current, top, _CMP_LT_OQ));
+
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(hit));
+        if (mask) return i + lowestSetBit(mask);
+    }
+    return findLandingScalar(x, y, flags, i, end, q);
+}
+#endif
+
+// Widest kernel the build targets: AVX2 with -mavx2 (/arch:AVX2), SSE2 on any
+// x86-64, otherwise the scalar loop.
+inline int findLanding(const float* x, const float* y, const uint8_t* flags,
+                       int begin, int end, const LandingQuery& q) {
+#if LANDING_KERNEL_AVX2
+    return findLandingAvx2(x, y, flags, begin, end, q);
+#elif LANDING_KERNEL_SSE2
+    return findLandingSse2(x, y, flags, begin, end, q);
+#else
+    return findLandingScalar(x, y, flags, begin, end, q);
+#endif
+}
+
+// The kernel findLanding() runs in this build, for benchmark headers.
+inline const char* landingKernelName() {
+#if LANDING_KERNEL_AVX2
+    return "avx2";
+#elif LANDING_KERNEL_SSE2
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+// Slot of the lowest live platform the player lands on, or -1. Only a
+// platform whose top lies in (bottomCurrent, bottomPrevious] can pass the
+// crossing test, and platforms are sorted by top, so two binary searches
+// narrow the sweep to that band (usually zero or one platform) without
+// changing which platform is hit first.
+inline int findLanding(const PlatformStore& platforms, const LandingQuery& q) {
+    size_t first = platforms.firstTopAbove(q.bottomCurrent);
+    size_t last = platforms.firstTopAbove(q.bottomPrevious);
+    SlotRange ranges[2];
+    int rangeCount = platforms.slotRanges(first, last, ranges);
+    for (int r = 0; r < rangeCount; ++r) {
+        int hit = findLanding(platforms.x.data(), platforms.y.data(), platforms.flags.data(),
+                              static_cast<int>(ranges[r].begin), static_cast<int>(ranges[r].end), q);
+        if (hit >= 0) return hit;
+    }
+    return -1;
+}
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+#include "chunk_arena.h"
+#include "collectibles.h"
+#include "platform_store.h"
+#include "reachability.h"
+#include "rng.h"
+
+// The level is cut into chunks of a fixed number of platforms. Platform k
+// (counting from the spawn platform) sits at firstY + k * spacing, so chunk c
+// always covers the same y band, and its contents come from a generator
+// seeded with (worldSeed, c) alone. Any chunk can be built on any thread, in
+// any order, and it comes out the same.
+struct LevelParams {
+    int width = 400;
+    float spacing = 80.0f;
+    int platformsPerChunk = 8;
+    float firstY = 50.0f;
+    // Physics the layout has to be playable under; jump.width is the level
+    // width too. With repair off, chunks come out exactly as drawn.
+    JumpModel jump;
+    bool repair = true;
+
+    float chunkHeight() const { return spacing * platformsPerChunk; }
+    // y of the lowest platform in chunk `index`.
+    float chunkBottom(long long index) const { return firstY + spacing * platformsPerChunk * index; }
+};
+
+struct ChunkPlatform {
+    float x, y;
+    PlatformType type;
+};
+
+// One chunk's entities on their way into the world, each list sorted by y.
+// All of them live in the chunk's arena, so clear() releases the lot in
+// O(1), and a chunk reused for the next one (queue slots, scratch chunks)
+// keeps its block. Splicing spawns each one as an entity in the world's
+// registry.
+struct LevelChunk {
+    long long index = -1;
+    int repaired = 0; // platforms moved or pinned to keep the climb reachable
+    ArenaList<ChunkPlatform> platforms;
+    ArenaList<Coin> coins;
+    ArenaList<HighJumpPowerUp> powerUps;
+
+    // A chunk holds one coin per platform and at most one power-up per
+    // platform, plus the first chunk's extra one. Clears the chunk if the
+    // block has to grow.
+    void reserve(int platformsPerChunk) {
+        if (platformsPerChunk <= reservedFor) return;
+        size_t n = static_cast<size_t>(platformsPerChunk);
+        arena.reserve(ChunkArena::bytesFor<ChunkPlatform>(n) + ChunkArena::bytesFor<Coin>(n) +
+                      ChunkArena::bytesFor<HighJumpPowerUp>(n + 1));
+        platforms.bind(arena.allocate<ChunkPlatform>(n), n);
+        coins.bind(arena.allocate<Coin>(n), n);
+        powerUps.bind(arena.allocate<HighJumpPowerUp>(n + 1), n + 1);
+        reservedFor = platformsPerChunk;
+        index = -1;
+        repaired = 0;
+    }
+
+    void clear() {
+        index = -1;
+        repaired = 0;
+        platforms.clear();
+        coins.clear();
+        powerUps.clear();
+    }
+
+private:
+    ChunkArena arena;
+    int reservedFor = 0;
+};
+
+inline PlatformType rollPlatformType(Pcg32& rng) {
+    bool isMoving = (rng.below(10) < 2);
+    bool isBreakable = (rng.below(10) < 2 && !isMoving);
+    if (isMoving) return PLATFORM_MOVING;
+    return isBreakable ? PLATFORM_BREAKABLE : PLATFORM_NORMAL;
+}
+
+// Draws chunk `index` into `out` as the dice fall. The chunk index picks the
+// PCG stream, so neighbouring chunks draw from unrelated sequences.
+inline void drawChunk(const LevelParams& params, uint64_t worldSeed, long long index, LevelChunk& out) {
+    out.reserve(params.platformsPerChunk);
+    out.clear();
+    out.index = index;
+    Pcg32 rng;
+    rng.reseed(worldSeed, static_cast<uint64_t>(index));
+
+    const float platformHeight = kPlatformTypes[PLATFORM_NORMAL].height;
+    float y = params.chunkBottom(index);
+    for (int i = 0; i < params.platformsPerChunk; ++i, y += params.spacing) {
+        ChunkPlatform p;
+        if (index == 0 && i == 0) {
+            p = { params.width / 2.0f, y, PLATFORM_NORMAL }; // spawn platform
+        }
+        else {
+            float randX = rng.below(params.width - 60) + 30;
+            p = { randX, y, rollPlatformType(rng) };
+        }
+        out.platforms.push_back(p);
+
+        float top = y + platformHeight / 2;
+        out.coins.emplace_back(p.x, top + 7.5f + 5.0f);
+
+        // The first chunk always has one power-up a few platforms up; later
+        // ones roll for it on every platform.
+        if (index != 0 && rng.below(15) == 0) {
+            float hjpuX = rng.below(params.width - 60) + 30;
+            float hjpuY = top + 10.0f + rng.below(20);
+            if (!out.powerUps.empty()) hjpuY = std::max(hjpuY, out.powerUps.back().y);
+            out.powerUps.emplace_back(hjpuX, hjpuY);
+        }
+    }
+
+    if (index == 0 && params.platformsPerChunk > 4) {
+        float randX = rng.below(params.width - 40) + 20;
+        int target = rng.below(params.platformsPerChunk / 2) + params.platformsPerChunk / 3;
+        float top = out.platforms[target].y + platformHeight / 2;
+        out.powerUps.emplace_back(randX, top + 10.0f + 5.0f);
+    }
+}
+
+// x moved `step` along the wrap circle toward `to`, stopping at the edge of
+// the generator's track [30, width - 30] rather than in the off-screen gap.
+inline float stepToward(const JumpModel& jump, float from, float to, float step) {
+    const float wrap = jump.wrapWidth();
+    const float lo = 30.0f, hi = jump.width - 30.0f;
+    float ahead = std::fmod(to - from, wrap);
+    if (ahead < 0) ahead += wrap;
+    bool right = ahead <= wrap / 2;
+    float x = from + (right ? 1.0f : -1.0f) * std::min(step, std::min(ahead, wrap - ahead));
+    const float origin = -jump.playerWidth / 2;
+    x = std::fmod(x - origin, wrap);
+    if (x < 0) x += wrap;
+    x += origin;
+    if (x < lo || x > hi) x = right ? hi : lo;
+    return x;
+}
+
+// Makes each platform of `chunk` reachable from the one below it, the first
+// from `below` (the previous chunk's top, null for the spawn chunk), and
+// keeps each within reach of this chunk's top in the hops left. The top
+// platform is left as drawn so the next chunk can reproduce it by drawing
+// this one. A platform that fails is pinned if moving, then moved toward the
+// top, then made unbreakable if it still fails. Repairs draw no numbers.
+template <typename Arc>
+void repairChunk(const LevelParams& params, const ChunkPlatform* below, LevelChunk& chunk) {
+    const JumpModel& jump = params.jump;
+    ArenaList<ChunkPlatform>& platforms = chunk.platforms;
+    const float hop = Arc::reach(jump, params.spacing); // worst case one level up
+    if (hop < 0 || platforms.empty()) return;     // spacing is over the apex
+    const ChunkPlatform& top = platforms.back();
+    const size_t last = platforms.size() - 1;
+
+    for (size_t k = 0; k < last; ++k) {
+        const ChunkPlatform* from = k == 0 ? below : &platforms[k - 1];
+        if (!from) continue; // spawn platform
+        ChunkPlatform& p = platforms[k];
+        auto fits = [&] {
+            bool reached = jump.canReach<Arc>(from->x, from->y, from->type, p.x, p.y, p.type);
+            if (k + 1 == last) return reached && jump.canReach<Arc>(p.x, p.y, p.type, top.x, top.y, top.type);
+            return reached && jump.circularDistance(p.x, top.x) <= (last - k) * hop;
+        };
+        if (fits()) continue;
+        chunk.repaired++;
+        if (p.type == PLATFORM_MOVING) p.type = PLATFORM_NORMAL;
+        if (!fits()) p.x = stepToward(jump, from->x, top.x, hop);
+        if (!fits() && p.type == PLATFORM_BREAKABLE) p.type = PLATFORM_NORMAL;
+        chunk.coins[k].x = p.x;
+    }
+}
+
+// Where generateChunk redraws the chunk below, one per thread. Threads that
+// must not allocate mid-run reserve it up front.
+inline LevelChunk& belowChunkScratch() {
+    thread_local LevelChunk below;
+    return below;
+}
+
+// Builds chunk `index` into `out`: drawn, then repaired against the top of
+// the chunk below, which is drawn again here so chunks stay independent.
+inline void generateChunk(const LevelParams& params, uint64_t worldSeed, long long index, LevelChunk& out) {
+    drawChunk(params, worldSeed, index, out);
+    if (!params.repair) return;
+    const ChunkPlatform* top = nullptr;
+    if (index > 0) {
+        LevelChunk& below = belowChunkScratch();
+        drawChunk(params, worldSeed, index - 1, below);
+        top = &below.platforms.back();
+    }
+    withArc(params.jump, [&](auto arc) { repairChunk<decltype(arc)>(params, top, out); });
+}
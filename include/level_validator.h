@@ -0,0 +1,165 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <ostream>
+#include <vector>
+
+#include "level_chunks.h"
+#include "bench_stats.h"
+#include "thread_pool.h"
+
+// Batch reachability check of generated levels: builds the first chunks of
+// many seeds exactly as the game streams them and walks each climb with the
+// closed-form jump model, no simulation involved.
+
+struct ValidationParams {
+    LevelParams level;
+    long long chunksPerSeed = 64;
+    uint64_t baseSeed = 1;
+};
+
+struct SeedReport {
+    uint64_t seed = 0;
+    long long platforms = 0;
+    long long unreachable = 0; // no reachable platform below can land on it
+    long long repaired = 0;
+    long long deadEndChunk = -1; // first chunk the climb cannot get past
+};
+
+struct ValidationResults {
+    long long chunks = 0;
+    long long platforms = 0;
+    long long unreachable = 0;
+    long long repaired = 0;
+    long long deadEnds = 0;
+    std::vector<SeedReport> seeds;
+    double seconds = 0.0;
+    unsigned threads = 0;
+
+    void add(const SeedReport& report, long long chunksBuilt) {
+        chunks += chunksBuilt;
+        platforms += report.platforms;
+        unreachable += report.unreachable;
+        repaired += report.repaired;
+        if (report.deadEndChunk >= 0) deadEnds++;
+        seeds.push_back(report);
+    }
+
+    void merge(const ValidationResults& other) {
+        chunks += other.chunks;
+        platforms += other.platforms;
+        unreachable += other.unreachable;
+        repaired += other.repaired;
+        deadEnds += other.deadEnds;
+        seeds.insert(seeds.end(), other.seeds.begin(), other.seeds.end());
+    }
+
+    void print(std::ostream& out) const {
+        long long seedCount = static_cast<long long>(seeds.size());
+        out << "seeds: " << seedCount << "  chunks: " << chunks << "  threads: " << threads
+            << "  time: " << seconds << " s"
+            << "  chunks/sec: " << perSecond(chunks, seconds) << '\n';
+        out << "unreachable platforms: " << unreachable << " of " << platforms
+            << " (" << (platforms ? 100.0 * unreachable / platforms : 0.0) << "%)"
+            << "  repaired: " << repaired << '\n';
+        out << "seeds with a dead end: " << deadEnds
+            << " (" << (seedCount ? 100.0 * deadEnds / seedCount : 0.0) << "%)\n";
+        out.flush();
+    }
+
+    void writeCsv(std::ostream& out) const {
+        out << "seed,platforms,unreachable,failure_rate,repaired,dead_end_chunk\n";
+        for (const SeedReport& r : seeds) {
+            out << r.seed << ',' << r.platforms << ',' << r.unreachable << ','
+                << (r.platforms ? static_cast<double>(r.unreachable) / r.platforms : 0.0) << ','
+                << r.repaired << ',' << r.deadEndChunk << '\n';
+        }
+    }
+};
+
+// Walks the first chunksPerSeed chunks of `seed`. A platform is reachable if
+// some reachable platform below it can land on it; only those within an
+// apex below can, so `window` holds just them. When it runs empty the climb
+// is over. Returns the number of chunks built.
+template <typename Arc>
+long long validateSeedWith(const ValidationParams& params, uint64_t seed, LevelChunk& chunk,
+                           std::vector<ChunkPlatform>& window, SeedReport& report) {
+    const JumpModel& jump = params.level.jump;
+    const float apex = Arc::apex(jump);
+    report = SeedReport();
+    report.seed = seed;
+    window.clear();
+
+    long long c = 0;
+    for (; c < params.chunksPerSeed && report.deadEndChunk < 0; ++c) {
+        generateChunk(params.level, seed, c, chunk);
+        report.repaired += chunk.repaired;
+        for (const ChunkPlatform& p : chunk.platforms) {
+            report.platforms++;
+            if (c == 0 && window.empty()) { // spawn platform
+                window.push_back(p);
+                continue;
+            }
+            size_t stale = 0;
+            while (stale < window.size() && window[stale].y < p.y - apex) ++stale;
+            window.erase(window.begin(), window.begin() + stale);
+            if (window.empty()) {
+                report.deadEndChunk = c;
+                break;
+            }
+            bool reached = std::any_of(window.begin(), window.end(), [&](const ChunkPlatform& w) {
+                return jump.canReach<Arc>(w.x, w.y, w.type, p.x, p.y, p.type);
+            });
+            if (reached) window.push_back(p);
+            else report.unreachable++;
+        }
+    }
+    return c;
+}
+
+inline long long validateSeed(const ValidationParams& params, uint64_t seed, LevelChunk& chunk,
+                              std::vector<ChunkPlatform>& window, SeedReport& report) {
+    return withArc(params.level.jump, [&](auto arc) {
+        return validateSeedWith<decltype(arc)>(params, seed, chunk, window, report);
+    });
+}
+
+// Validates `seedCount` seeds from baseSeed across the pool, in blocks
+// claimed from a shared counter like the farm. Per-seed reports come back
+// sorted by seed whatever the thread count.
+inline ValidationResults runValidation(long long seedCount, const ValidationParams& params, ThreadPool& pool) {
+    const long long blockSize = 64;
+    std::atomic<long long> nextSeed(0);
+    std::vector<ValidationResults> perWorker(pool.size());
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned w = 0; w < pool.size(); ++w) {
+        pool.submit([&, w] {
+            LevelChunk chunk;
+            std::vector<ChunkPlatform> window;
+            ValidationResults& local = perWorker[w];
+            for (;;) {
+                long long first = nextSeed.fetch_add(blockSize, std::memory_order_relaxed);
+                if (first >= seedCount) break;
+                long long last = std::min(first + blockSize, seedCount);
+                for (long long i = first; i < last; ++i) {
+                    SeedReport report;
+                    long long built = validateSeed(params, params.baseSeed + static_cast<uint64_t>(i),
+                                                   chunk, window, report);
+                    local.add(report, built);
+                }
+            }
+        });
+    }
+    pool.wait();
+
+    ValidationResults total;
+    for (const auto& r : perWorker) total.merge(r);
+    std::sort(total.seeds.begin(), total.seeds.end(),
+              [](const SeedReport& a, const SeedReport& b) { return a.seed < b.seed; });
+    total.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    total.threads = pool.size();
+    return total;
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ring_buffer.h"
+
+enum PlatformType : uint8_t {
+    PLATFORM_NORMAL,
+    PLATFORM_MOVING,
+    PLATFORM_BREAKABLE,
+    PLATFORM_TYPE_COUNT
+};
+
+// Size never varies within a type, so it lives here and not per platform.
+struct PlatformTypeInfo {
+    float width;
+    float height;
+};
+
+constexpr PlatformTypeInfo kPlatformTypes[PLATFORM_TYPE_COUNT] = {
+    { 60.0f, 10.0f }, // PLATFORM_NORMAL
+    { 60.0f, 10.0f }, // PLATFORM_MOVING
+    { 60.0f, 10.0f }, // PLATFORM_BREAKABLE
+};
+
+// Low two bits of a flag byte hold the PlatformType, the rest are state.
+constexpr uint8_t PLATFORM_TYPE_MASK = 0x03;
+constexpr uint8_t PLATFORM_BROKEN = 0x04;
+
+constexpr float kPlatformSpeed = 2.0f;
+
+// Platforms as parallel arrays, kept sorted by y (generation only appends
+// higher platforms). The game keeps its platforms as registry entities (see
+// ecs_systems.h); this layout is what the SIMD landing kernels sweep, and
+// what --bench-platforms and --bench-landing measure. The hot loops touch only the arrays they need: moving
+// reads flags/x/velX, landing reads flags/x/y.
+//
+// The arrays are a ring: platforms expire strictly from the bottom, so
+// retiring them just advances the head. Broken platforms stay in place as
+// tombstones (PLATFORM_BROKEN) until they reach the front. Array indices are
+// physical slots; use slot(i) for the i-th lowest platform and liveRanges()
+// to sweep them in order.
+class PlatformStore : public RingSlots {
+public:
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> velX;
+    std::vector<uint8_t> flags;
+
+    void clear() {
+        head = 0;
+        count = 0;
+    }
+
+    // Sizes the arrays for n live platforms up front.
+    void reserve(size_t n) {
+        if (n > capacityValue) grow(capacityFor(n));
+    }
+
+    void add(float px, float py, PlatformType type) {
+        if (count == capacityValue) grow(nextCapacity());
+        size_t s = slot(count);
+        x[s] = px;
+        y[s] = py;
+        velX[s] = kPlatformSpeed;
+        flags[s] = type;
+        ++count;
+    }
+
+    size_t frontSlot() const { return head; }
+    size_t backSlot() const { return slot(count - 1); }
+
+    PlatformType type(size_t s) const { return static_cast<PlatformType>(flags[s] & PLATFORM_TYPE_MASK); }
+    bool broken(size_t s) const { return (flags[s] & PLATFORM_BROKEN) != 0; }
+    void setBroken(size_t s) { flags[s] |= PLATFORM_BROKEN; }
+    float width(size_t s) const { return kPlatformTypes[type(s)].width; }
+    float height(size_t s) const { return kPlatformTypes[type(s)].height; }
+
+    // Logical index of the lowest platform whose top is above `value`, or
+    // size() if none. Tops are non-decreasing in logical order because y is
+    // and every type has the same height (see landing_kernel.h).
+    size_t firstTopAbove(float value) const {
+        size_t lo = 0, hi = count;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            size_t s = slot(mid);
+            if (value < y[s] + height(s) / 2) hi = mid;
+            else lo = mid + 1;
+        }
+        return lo;
+    }
+
+    // Moving platforms bounce between the side walls. Written without
+    // branches (static platforms add 0) so the loop vectorizes instead of
+    // mispredicting on the random mix of types.
+    void update(int worldWidth) {
+        const float halfWidth = kPlatformTypes[PLATFORM_MOVING].width / 2;
+        const float right = worldWidth - halfWidth;
+        float* px = x.data();
+        float* pv = velX.data();
+        const uint8_t* pf = flags.data();
+        SlotRange ranges[2];
+        int rangeCount = liveRanges(ranges);
+        for (int r = 0; r < rangeCount; ++r) {
+            for (size_t i = ranges[r].begin; i < ranges[r].end; ++i) {
+                bool moving = pf[i] == PLATFORM_MOVING; // moving and not broken
+                float nx = px[i] + (moving ? pv[i] : 0.0f);
+                bool bounce = moving && (nx < halfWidth || nx > right);
+                px[i] = nx;
+                pv[i] = bounce ? -pv[i] : pv[i];
+            }
+        }
+    }
+
+    // Retires platforms from the bottom while they are more than their own
+    // height below `limit`. Costs one compare per retired platform plus one.
+    void removeBelow(float limit) {
+        while (count > 0 && y[head] < limit - height(head)) {
+            popFront();
+        }
+    }
+
+private:
+    void grow(size_t newCapacity) {
+        std::vector<float> nx(newCapacity), ny(newCapacity), nv(newCapacity);
+        std::vector<uint8_t> nf(newCapacity);
+        for (size_t i = 0; i < count; ++i) {
+            size_t s = slot(i);
+            nx[i] = x[s];
+            ny[i] = y[s];
+            nv[i] = velX[s];
+            nf[i] = flags[s];
+        }
+        x.swap(nx);
+        y.swap(ny);
+        velX.swap(nv);
+        flags.swap(nf);
+        head = 0;
+        capacityValue = newCapacity;
+    }
+};
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include "jump_arc.h"
+#include "platform_store.h"
+
+// The player's jump in closed form, for checking a layout without stepping a
+// world. Each tick velocity drops by gravity and then moves the player, so t
+// ticks after bouncing at speed v0 the feet are
+//
+//     h(t) = v0 t - g t (t + 1) / 2
+//
+// above the platform top. Horizontally the screen wraps: the player leaves
+// one side at playerWidth / 2 past the edge and comes in the other, so x
+// lives on a circle of width + playerWidth.
+//
+// How the arc is evaluated is a template parameter (an Arc policy, below):
+// the closed form for physics swept at run time, or a compiled profile's
+// JumpArc tables, which are exact per tick where the float square root can
+// be a tick off at the boundaries. Code that checks many jumps is templated
+// on the policy and picks it once through withArc().
+struct JumpModel {
+    float gravity = DefaultPhysics::gravity;
+    float jumpStrength = DefaultPhysics::jumpStrength;
+    float moveSpeed = DefaultPhysics::moveSpeed;
+    float playerWidth = 50.0f;
+    int width = 400;
+
+    template <typename Profile>
+    bool hasPhysicsOf() const {
+        return gravity == Profile::gravity && jumpStrength == Profile::jumpStrength && moveSpeed == Profile::moveSpeed;
+    }
+
+    // The continuous peak, which the tick-sampled one never exceeds.
+    float apexHeight() const {
+        float b = jumpStrength - gravity / 2;
+        return b * b / (2 * gravity);
+    }
+
+    // Tick on which a player falling through a top dy above the launch top
+    // lands on it: the first tick past the descending root of h(t) = dy. -1
+    // if no tick of the arc reaches dy.
+    int landingTick(float dy) const {
+        float b = jumpStrength - gravity / 2;
+        float disc = b * b - 2 * gravity * dy;
+        if (disc < 0) return -1;
+        float root = std::sqrt(disc);
+        int first = std::max(1, static_cast<int>(std::ceil((b - root) / gravity)));
+        int last = static_cast<int>(std::floor((b + root) / gravity));
+        return last >= first ? last + 1 : -1;
+    }
+
+    // Horizontal distance covered between bouncing and landing dy higher, or
+    // -1 if dy is out of reach. One tick short of the arc, which absorbs the
+    // float drift of the simulation's accumulated position.
+    float reach(float dy) const {
+        int land = landingTick(dy);
+        return land < 0 ? -1.0f : moveSpeed * (land - 1);
+    }
+
+    float wrapWidth() const { return width + playerWidth; }
+
+    float circularDistance(float a, float b) const {
+        float d = std::fmod(std::fabs(a - b), wrapWidth());
+        return std::min(d, wrapWidth() - d);
+    }
+
+    // Farthest point of a moving platform's track from x.
+    float farthestOnTrack(float x) const {
+        float lo = kPlatformTypes[PLATFORM_MOVING].width / 2;
+        float hi = width - lo;
+        float antipode = std::fmod(x + wrapWidth() / 2, wrapWidth());
+        if (antipode >= lo && antipode <= hi) return wrapWidth() / 2;
+        return std::max(circularDistance(x, lo), circularDistance(x, hi));
+    }
+
+    // Whether a player on platform `from` can land on platform `to` in one
+    // jump, without a boost. Conservative where the answer depends on play:
+    //
+    // - A normal platform can be bounced on until the player is anywhere
+    //   across it, so the jump may start from either edge.
+    // - A breakable platform gives one jump from wherever the player landed;
+    //   assume the edge facing away from the target.
+    // - The player outruns a moving platform (twice its speed), so from one
+    //   it can line up under any point of the track: always reachable.
+    // - A moving target is waited for from a normal platform; from a
+    //   breakable one, every point of its track has to be in reach.
+    template <typename Arc>
+    bool canReach(float fromX, float fromY, PlatformType fromType,
+                  float toX, float toY, PlatformType toType) const {
+        float r = Arc::reach(*this, toY - fromY);
+        if (r < 0) return false;
+        if (fromType == PLATFORM_MOVING) return true;
+
+        bool oneShot = fromType == PLATFORM_BREAKABLE;
+        float launchSlack = (playerWidth + kPlatformTypes[fromType].width) / 2;
+        float landSlack = (playerWidth + kPlatformTypes[toType].width) / 2;
+        float distance;
+        if (toType == PLATFORM_MOVING) distance = oneShot ? farthestOnTrack(fromX) : 0.0f;
+        else distance = circularDistance(fromX, toX);
+        return distance <= r + landSlack + (oneShot ? -launchSlack : launchSlack);
+    }
+};
+
+// Arc policies: reach(jump, dy) and apex(jump) for JumpModel's checks, and
+// remainingRise(jump, v), the climb still ahead of a player moving up at v.
+struct ClosedFormArc {
+    static float reach(const JumpModel& jump, float dy) { return jump.reach(dy); }
+    static float apex(const JumpModel& jump) { return jump.apexHeight(); }
+    // The continuous peak, a few pixels above the tick-sampled one.
+    static float remainingRise(const JumpModel& jump, float v) { return v * v / (2 * jump.gravity); }
+};
+
+// Profile's tables; only valid for a model with hasPhysicsOf<Profile>().
+template <typename Profile>
+struct TableArc {
+    static constexpr float reach(const JumpModel&, float dy) { return JumpArc<Profile>::reachFor(dy); }
+    static constexpr float apex(const JumpModel&) { return JumpArc<Profile>::kApexHeight; }
+    // Tick-exact on a normal jump; a boosted one isn't on the table's arc.
+    static float remainingRise(const JumpModel& jump, float v) {
+        float rise = JumpArc<Profile>::remainingRise(v);
+        return rise < 0 ? ClosedFormArc::remainingRise(jump, v) : rise;
+    }
+};
+
+// Calls f with the tables for jump's physics if they were compiled in, else
+// with the closed form. One branch per call; everything f instantiates for
+// the table policy has the profile's constants folded in.
+template <typename F>
+decltype(auto) withArc(const JumpModel& jump, F&& f) {
+    if (jump.hasPhysicsOf<DefaultPhysics>()) return f(TableArc<DefaultPhysics>());
+    return f(ClosedFormArc());
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// A contiguous run of physical slots [begin, end).
+struct SlotRange {
+    size_t begin;
+    size_t end;
+};
+
+// Index math for a power-of-two ring. Logical index 0 is the oldest entry;
+// entities are appended at the back and retired from the front by moving the
+// head, so retiring costs nothing per live entity.
+class RingSlots {
+public:
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    size_t capacity() const { return capacityValue; }
+
+    // Physical slot of logical index i.
+    size_t slot(size_t i) const { return (head + i) & (capacityValue - 1); }
+
+    // Slots of logical indices [first, last) in order, as at most two
+    // contiguous runs (the second only when they wrap past the end).
+    int slotRanges(size_t first, size_t last, SlotRange out[2]) const {
+        if (first >= last) return 0;
+        size_t begin = slot(first);
+        size_t end = begin + (last - first);
+        if (end <= capacityValue) {
+            out[0] = { begin, end };
+            return 1;
+        }
+        out[0] = { begin, capacityValue };
+        out[1] = { 0, end - capacityValue };
+        return 2;
+    }
+
+    int liveRanges(SlotRange out[2]) const { return slotRanges(0, count, out); }
+
+    void popFront(size_t n = 1) {
+        head = (head + n) & (capacityValue - 1);
+        count -= n;
+    }
+
+protected:
+    size_t nextCapacity() const { return capacityValue ? capacityValue * 2 : 16; }
+
+    // Smallest capacity the ring would grow to that holds n.
+    size_t capacityFor(size_t n) const {
+        size_t c = nextCapacity();
+        while (c < n) c *= 2;
+        return c;
+    }
+
+    size_t head = 0;
+    size_t count = 0;
+    size_t capacityValue = 0;
+};
+
+// FIFO of T in a ring. Entities that die out of order (collected coins) are
+// expected to be tombstoned in place and retired when they reach the front.
+template <typename T>
+class Ring : public RingSlots {
+public:
+    using value_type = T;
+
+    T& operator[](size_t i) { return items[slot(i)]; }
+    const T& operator[](size_t i) const { return items[slot(i)]; }
+    T& front() { return items[head]; }
+    const T& front() const { return items[head]; }
+    T& back() { return items[slot(count - 1)]; }
+    const T& back() const { return items[slot(count - 1)]; }
+
+    // Storage in physical slot order, for loops over liveRanges().
+    T* data() { return items.data(); }
+    const T* data() const { return items.data(); }
+
+    void clear() {
+        head = 0;
+        count = 0;
+    }
+
+    // Sizes the ring for n live entries up front, so appends up to that
+    // never allocate.
+    void reserve(size_t n) {
+        if (n > capacityValue) grow(capacityFor(n));
+    }
+
+    template <typename... Args>
+    void emplace_back(Args&&... args) {
+        if (count == capacityValue) grow(nextCapacity());
+        items[slot(count)] = T(std::forward<Args>(args)...);
+        ++count;
+    }
+
+private:
+    // Every slot is constructed, so the vector's size is the capacity and a
+    // copy of the ring (a snapshot) is sized once, not every time a slot is
+    // first used.
+    void grow(size_t newCapacity) {
+        std::vector<T> relinearized(newCapacity);
+        for (size_t i = 0; i < count; ++i) relinearized[i] = std::move(items[slot(i)]);
+        items.swap(relinearized);
+        head = 0;
+        capacityValue = newCapacity;
+    }
+
+    std::vector<T> items;
+};
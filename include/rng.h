@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+
+// PCG32 (O'Neill, pcg-random.org): 16 bytes of state, one multiply per draw.
+// Every GameWorld owns one, so a seed fully determines a run and worlds never
+// share generator state.
+class Pcg32 {
+public:
+    explicit Pcg32(uint64_t seed = 0x853c49e6748fea9bULL) { reseed(seed); }
+
+    void reseed(uint64_t seed, uint64_t stream = 0xda3e39cb94b95bdbULL) {
+        state = 0;
+        inc = (stream << 1u) | 1u;
+        next();
+        state += seed;
+        next();
+    }
+
+    uint32_t next() {
+        uint64_t old = state;
+        state = old * 6364136223846793005ULL + inc;
+        uint32_t xorshifted = static_cast<uint32_t>(((old >> 18u) ^ old) >> 27u);
+        uint32_t rot = static_cast<uint32_t>(old >> 59u);
+        return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+    }
+
+    // Uniform integer in [0, bound). Multiply-shift instead of %, so no
+    // division; the bias is below 2^-32 * bound, far under anything we draw.
+    int below(int bound) {
+        return static_cast<int>((static_cast<uint64_t>(next()) * static_cast<uint32_t>(bound)) >> 32);
+    }
+
+private:
+    uint64_t state;
+    uint64_t inc;
+};
@@ -0,0 +1,240 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <ostream>
+#include <vector>
+
+#include "bench_stats.h"
+#include "game_world.h"
+#include "thread_pool.h"
+
+// Batch balance testing: many independent headless episodes spread over a
+// thread pool, each driven by a scripted policy, reduced into distributions.
+
+struct FarmParams {
+    float gravity = DefaultPhysics::gravity;
+    float jumpStrength = DefaultPhysics::jumpStrength;
+    float boostedJumpStrength = DefaultPhysics::boostedJumpStrength;
+    float platformSpacing = 80.0f;
+    long long maxTicks = 20000;
+    uint64_t baseSeed = 1;
+
+    void applyTo(GameWorld& world) const {
+        world.gravity = gravity;
+        world.jumpStrength = jumpStrength;
+        world.boostedJumpStrength = boostedJumpStrength;
+        world.platformSpacing = platformSpacing;
+    }
+};
+
+// Per-episode policy state. Has its own generator so a policy's choices never
+// disturb the world's level generation stream.
+struct PolicyState {
+    Pcg32 rng;
+    PlayerInput held;
+    int holdTicks = 0;
+};
+
+using PolicyFn = PlayerInput (*)(const GameWorld&, PolicyState&);
+
+struct Policy {
+    const char* name;
+    PolicyFn decide;
+};
+
+inline PlayerInput idlePolicy(const GameWorld&, PolicyState&) {
+    return PlayerInput();
+}
+
+inline PlayerInput chasePolicy(const GameWorld& world, PolicyState&) {
+    return chaseNextPlatform(world);
+}
+
+// Mashes a random direction and holds it for 8-39 ticks.
+inline PlayerInput randomPolicy(const GameWorld&, PolicyState& state) {
+    if (state.holdTicks-- <= 0) {
+        state.held.moveDir = state.rng.below(3) - 1;
+        state.holdTicks = 8 + state.rng.below(32);
+    }
+    return state.held;
+}
+
+// The chase bot with a 10% chance per tick of a wrong key press.
+inline PlayerInput noisyChasePolicy(const GameWorld& world, PolicyState& state) {
+    if (state.rng.below(10) == 0) {
+        PlayerInput input;
+        input.moveDir = state.rng.below(3) - 1;
+        return input;
+    }
+    return chaseNextPlatform(world);
+}
+
+inline const Policy* findPolicy(const char* name) {
+    static const Policy policies[] = {
+        { "idle", idlePolicy },
+        { "chase", chasePolicy },
+        { "random", randomPolicy },
+        { "noisy", noisyChasePolicy },
+    };
+    for (const auto& p : policies) {
+        if (std::strcmp(p.name, name) == 0) return &p;
+    }
+    return nullptr;
+}
+
+class Histogram {
+public:
+    explicit Histogram(double bucketWidth) : bucketWidth(bucketWidth) {}
+
+    void add(double value) {
+        size_t bucket = value <= 0 ? 0 : static_cast<size_t>(value / bucketWidth);
+        if (bucket >= counts.size()) counts.resize(bucket + 1, 0);
+        counts[bucket]++;
+        total++;
+        sum += value;
+    }
+
+    void merge(const Histogram& other) {
+        if (other.counts.size() > counts.size()) counts.resize(other.counts.size(), 0);
+        for (size_t i = 0; i < other.counts.size(); ++i) counts[i] += other.counts[i];
+        total += other.total;
+        sum += other.sum;
+    }
+
+    double mean() const { return total ? sum / total : 0.0; }
+
+    // Lower edge of the bucket holding the q-quantile.
+    double quantile(double q) const {
+        long long rank = static_cast<long long>(q * (total - 1));
+        long long seen = 0;
+        for (size_t i = 0; i < counts.size(); ++i) {
+            seen += counts[i];
+            if (seen > rank) return i * bucketWidth;
+        }
+        return 0.0;
+    }
+
+    void writeCsv(std::ostream& out, const char* metric) const {
+        for (size_t i = 0; i < counts.size(); ++i) {
+            if (counts[i] == 0) continue;
+            out << metric << ',' << i * bucketWidth << ',' << (i + 1) * bucketWidth << ',' << counts[i] << '\n';
+        }
+    }
+
+    const double bucketWidth;
+    std::vector<long long> counts;
+    long long total = 0;
+    double sum = 0.0;
+};
+
+enum EpisodeEnd { END_MISSED_JUMP, END_BROKEN_PLATFORM, END_TIMEOUT, END_COUNT };
+
+inline const char* episodeEndName(int end) {
+    static const char* names[END_COUNT] = { "missed_jump", "broken_platform", "timeout" };
+    return names[end];
+}
+
+struct FarmResults {
+    long long episodes = 0;
+    long long ticks = 0;
+    Histogram score{100.0};
+    Histogram height{1000.0};
+    long long ends[END_COUNT] = {};
+    double seconds = 0.0;
+    unsigned threads = 0;
+
+    void merge(const FarmResults& other) {
+        episodes += other.episodes;
+        ticks += other.ticks;
+        score.merge(other.score);
+        height.merge(other.height);
+        for (int i = 0; i < END_COUNT; ++i) ends[i] += other.ends[i];
+    }
+
+    void print(std::ostream& out) const {
+        out << "episodes: " << episodes << "  threads: " << threads
+            << "  time: " << seconds << " s"
+            << "  episodes/sec: " << perSecond(episodes, seconds)
+            << "  ticks/sec: " << perSecond(ticks, seconds) << '\n';
+        out << "score  mean " << score.mean() << "  p50 " << score.quantile(0.5)
+            << "  p90 " << score.quantile(0.9) << "  p99 " << score.quantile(0.99) << '\n';
+        out << "height mean " << height.mean() << "  p50 " << height.quantile(0.5)
+            << "  p90 " << height.quantile(0.9) << "  p99 " << height.quantile(0.99) << '\n';
+        for (int i = 0; i < END_COUNT; ++i) {
+            out << episodeEndName(i) << ": " << ends[i]
+                << " (" << (episodes ? 100.0 * ends[i] / episodes : 0.0) << "%)\n";
+        }
+        out.flush();
+    }
+
+    void writeCsv(std::ostream& out) const {
+        out << "metric,bucket_lo,bucket_hi,count\n";
+        score.writeCsv(out, "score");
+        height.writeCsv(out, "height");
+        for (int i = 0; i < END_COUNT; ++i) {
+            out << "end," << episodeEndName(i) << ",," << ends[i] << '\n';
+        }
+    }
+};
+
+// Plays episode `index` to the end and folds it into `results`. The world is
+// reused between episodes so its vectors keep their capacity.
+inline void runEpisode(GameWorld& world, long long index, const FarmParams& params,
+                       const Policy& policy, FarmResults& results) {
+    uint64_t seed = params.baseSeed + static_cast<uint64_t>(index);
+    params.applyTo(world);
+    world.reset(seed);
+
+    PolicyState state;
+    state.rng.reseed(seed, 0x9e3779b97f4a7c15ULL);
+
+    while (!world.gameOver && world.ticks < params.maxTicks) {
+        world.step(policy.decide(world, state));
+    }
+
+    int end = END_TIMEOUT;
+    if (world.gameOver) {
+        end = world.deathCause == DeathCause::BrokenPlatform ? END_BROKEN_PLATFORM : END_MISSED_JUMP;
+    }
+    results.episodes++;
+    results.ticks += world.ticks;
+    results.score.add(world.score);
+    results.height.add(world.cameraY);
+    results.ends[end]++;
+}
+
+// Runs `episodes` episodes across the pool. Workers claim small blocks of
+// episode indices from a shared counter and reduce into private results, so
+// the only shared write per block is one fetch_add. Episode i always uses
+// seed baseSeed + i, so results do not depend on the thread count.
+inline FarmResults runFarm(long long episodes, const FarmParams& params,
+                           const Policy& policy, ThreadPool& pool) {
+    const long long blockSize = 64;
+    std::atomic<long long> nextEpisode(0);
+    std::vector<FarmResults> perWorker(pool.size());
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned w = 0; w < pool.size(); ++w) {
+        pool.submit([&, w] {
+            GameWorld world;
+            FarmResults& local = perWorker[w];
+            for (;;) {
+                long long first = nextEpisode.fetch_add(blockSize, std::memory_order_relaxed);
+                if (first >= episodes) break;
+                long long last = std::min(first + blockSize, episodes);
+                for (long long i = first; i < last; ++i) {
+                    runEpisode(world, i, params, policy, local);
+                }
+            }
+        });
+    }
+    pool.wait();
+
+    FarmResults total;
+    for (const auto& r : perWorker) total.merge(r);
+    total.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    total.threads = pool.size();
+    return total;
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "gl_loader.h"
+#include "texture_atlas.h"
+
+struct Color {
+    float r, g, b;
+};
+
+// Interleaved position + texture coordinate + color, 20 bytes per vertex.
+struct SpriteVertex {
+    float x, y;
+    float u, v;
+    uint8_t r, g, b, a;
+};
+
+// Collects every axis-aligned quad of a frame into one vertex array and
+// submits it with a single glDrawArrays. The array lives in a streamed VBO
+// when the context has buffer objects (GL 1.5+), otherwise it is passed as a
+// client-side array (GL 1.1). The CPU-side array keeps its capacity between
+// frames, so steady-state frames don't allocate.
+//
+// With an atlas set, every quad samples it: sprites through their own UV
+// rect, flat rects through the atlas's white block. The whole frame is still
+// one draw with one texture bind.
+class SpriteBatch {
+public:
+    // Deletes the VBO; needs the context init() ran under. Like
+    // InstancedRenderer::release(), never called from a destructor.
+    void release() {
+        if (!vbo) return;
+        glFunctions().deleteBuffers(1, &vbo);
+        vbo = 0;
+    }
+
+    // Picks the submission path; needs a current GL context.
+    void init() {
+        GlFunctions& gl = glFunctions();
+        if (gl.hasBuffers() && !vbo) gl.genBuffers(1, &vbo);
+    }
+
+    bool usingVbo() const { return vbo != 0; }
+
+    void setAtlas(const TextureAtlas& atlas) {
+        texture = atlas.texture;
+        whiteUv = atlas.white();
+    }
+
+    void begin() {
+        vertices.clear();
+        dirty = true;
+    }
+
+    void addRect(float cx, float cy, float width, float height, const Color& color) {
+        addSprite(cx, cy, width, height, whiteUv, color);
+    }
+
+    // A quad textured with `uv` (v0 at its top edge), tinted by `color`.
+    void addSprite(float cx, float cy, float width, float height, const UvRect& uv, const Color& color) {
+        uint8_t r = static_cast<uint8_t>(color.r * 255.0f + 0.5f);
+        uint8_t g = static_cast<uint8_t>(color.g * 255.0f + 0.5f);
+        uint8_t b = static_cast<uint8_t>(color.b * 255.0f + 0.5f);
+        float left = cx - width / 2, right = cx + width / 2;
+        float bottom = cy - height / 2, top = cy + height / 2;
+        vertices.push_back({ left, bottom, uv.u0, uv.v1, r, g, b, 255 });
+        vertices.push_back({ right, bottom, uv.u1, uv.v1, r, g, b, 255 });
+        vertices.push_back({ right, top, uv.u1, uv.v0, r, g, b, 255 });
+        vertices.push_back({ left, top, uv.u0, uv.v0, r, g, b, 255 });
+    }
+
+    size_t quadCount() const { return vertices.size() / 4; }
+
+    // Draws everything added since begin() in one call. Flushing again
+    // without a begin() redraws the same quads without re-uploading them.
+    void flush() {
+        if (vertices.empty()) return;
+        const GLsizei stride = sizeof(SpriteVertex);
+        uintptr_t base = reinterpret_cast<uintptr_t>(vertices.data());
+
+        if (vbo) {
+            GlFunctions& gl = glFunctions();
+            gl.bindBuffer(GL_ARRAY_BUFFER, vbo);
+            if (dirty) {
+                GLsizeiptrCompat bytes = static_cast<GLsizeiptrCompat>(vertices.size() * sizeof(SpriteVertex));
+                if (bytes > vboBytes) vboBytes = bytes;
+                // Orphan last frame's storage so the driver need not wait on it.
+                gl.bufferData(GL_ARRAY_BUFFER, vboBytes, nullptr, GL_STREAM_DRAW);
+                gl.bufferSubData(GL_ARRAY_BUFFER, 0, bytes, vertices.data());
+            }
+            base = 0; // attribute pointers become offsets into the VBO
+        }
+
+        if (texture) {
+            glEnable(GL_TEXTURE_2D);
+            glBindTexture(GL_TEXTURE_2D, texture);
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+            glTexCoordPointer(2, GL_FLOAT, stride, reinterpret_cast<const void*>(base + offsetof(SpriteVertex, u)));
+        }
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glEnableClientState(GL_COLOR_ARRAY);
+        glVertexPointer(2, GL_FLOAT, stride, reinterpret_cast<const void*>(base + offsetof(SpriteVertex, x)));
+        glColorPointer(4, GL_UNSIGNED_BYTE, stride, reinterpret_cast<const void*>(base + offsetof(SpriteVertex, r)));
+        glDrawArrays(GL_QUADS, 0, static_cast<GLsizei>(vertices.size()));
+        glDisableClientState(GL_COLOR_ARRAY);
+        glDisableClientState(GL_VERTEX_ARRAY);
+        if (texture) {
+            glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+            glDisable(GL_BLEND);
+            glBindTexture(GL_TEXTURE_2D, 0);
+            glDisable(GL_TEXTURE_2D);
+        }
+
+        if (vbo) glFunctions().bindBuffer(GL_ARRAY_BUFFER, 0);
+        dirty = false;
+        drawCalls++;
+    }
+
+    long long drawCalls = 0;
+
+private:
+    std::vector<SpriteVertex> vertices;
+    GLuint vbo = 0;
+    GLsizeiptrCompat vboBytes = 0;
+    GLuint texture = 0;
+    UvRect whiteUv = {};
+    bool dirty = true;
+};
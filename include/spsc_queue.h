@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+// Bounded single-producer/single-consumer queue over a power-of-two ring.
+// Every operation is a fixed number of steps (wait-free): a full or empty
+// queue is reported, never waited on. Elements are written and read in place
+// and slots are reused, so elements that own memory (vectors) keep it.
+//
+// Each side caches the other's index and only reloads it when the cached
+// value says full (or empty), so the shared lines are touched rarely.
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+
+public:
+    // Producer: a free slot to fill, or null when full. The slot becomes
+    // visible to the consumer at commitPush().
+    T* pushSlot() {
+        size_t tail = tailIndex.load(std::memory_order_relaxed);
+        if (tail - headCache == Capacity) {
+            headCache = headIndex.load(std::memory_order_acquire);
+            if (tail - headCache == Capacity) return nullptr;
+        }
+        return &slots[tail & (Capacity - 1)];
+    }
+
+    void commitPush() {
+        tailIndex.store(tailIndex.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Consumer: the oldest element, or null when empty. It stays valid until
+    // pop().
+    T* front() {
+        size_t head = headIndex.load(std::memory_order_relaxed);
+        if (head == tailCache) {
+            tailCache = tailIndex.load(std::memory_order_acquire);
+            if (head == tailCache) return nullptr;
+        }
+        return &slots[head & (Capacity - 1)];
+    }
+
+    void pop() {
+        headIndex.store(headIndex.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Elements queued, as seen from either side; exact only when the other
+    // side is idle.
+    size_t size() const {
+        return tailIndex.load(std::memory_order_acquire) - headIndex.load(std::memory_order_acquire);
+    }
+
+    static constexpr size_t capacity() { return Capacity; }
+
+    // Slot i in storage order, for setting up elements (reserving their
+    // memory) while neither side is running.
+    T& slotAt(size_t i) { return slots[i]; }
+
+private:
+    T slots[Capacity];
+    alignas(64) std::atomic<size_t> headIndex{ 0 }; // written by the consumer
+    size_t tailCache = 0;                           // consumer's copy of tailIndex
+    alignas(64) std::atomic<size_t> tailIndex{ 0 }; // written by the producer
+    size_t headCache = 0;                           // producer's copy of headIndex
+};
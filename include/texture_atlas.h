@@ -0,0 +1,181 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <GL/glut.h>
+
+#include "stb_image.h"
+
+// Texture coordinates of one atlas entry. v0 is the image's top row.
+struct UvRect {
+    float u0, v0, u1, v1;
+};
+
+// Decodes PNGs through stb_image and shelf-packs them, plus a solid white
+// block for untextured quads, into one RGBA texture. Everything drawn in a
+// frame then shares a single texture bind.
+class TextureAtlas {
+public:
+    static constexpr int kPadding = 1;
+    static constexpr int kWhiteSize = 4;
+
+    // Decodes `path`, box-filtering it down by an integer factor until it
+    // fits in maxSize x maxSize. Returns false if it can't be read.
+    bool addImage(const std::string& name, const char* path, int maxSize) {
+        auto start = std::chrono::steady_clock::now();
+        int w = 0, h = 0, channels = 0;
+        unsigned char* pixels = stbi_load(path, &w, &h, &channels, 4);
+        if (!pixels) return false;
+
+        int factor = 1;
+        while (w / factor > maxSize || h / factor > maxSize) ++factor;
+
+        Entry e;
+        e.name = name;
+        e.width = w / factor;
+        e.height = h / factor;
+        e.pixels.resize(static_cast<size_t>(e.width) * e.height * 4);
+        for (int y = 0; y < e.height; ++y) {
+            for (int x = 0; x < e.width; ++x) {
+                unsigned sum[4] = { 0, 0, 0, 0 };
+                for (int sy = 0; sy < factor; ++sy) {
+                    const unsigned char* row = pixels + ((static_cast<size_t>(y) * factor + sy) * w + static_cast<size_t>(x) * factor) * 4;
+                    for (int sx = 0; sx < factor; ++sx) {
+                        for (int c = 0; c < 4; ++c) sum[c] += row[sx * 4 + c];
+                    }
+                }
+                for (int c = 0; c < 4; ++c) {
+                    e.pixels[(static_cast<size_t>(y) * e.width + x) * 4 + c] =
+                        static_cast<unsigned char>(sum[c] / (factor * factor));
+                }
+            }
+        }
+        stbi_image_free(pixels);
+        entries.push_back(std::move(e));
+
+        decodeSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return true;
+    }
+
+    // Adds an already decoded width x height RGBA image.
+    void addPixels(const std::string& name, int width, int height, const unsigned char* rgba) {
+        Entry e;
+        e.name = name;
+        e.width = width;
+        e.height = height;
+        e.pixels.assign(rgba, rgba + static_cast<size_t>(width) * height * 4);
+        entries.push_back(std::move(e));
+    }
+
+    // Places every entry on shelves (tallest first) in the smallest power of
+    // two square that fits, then computes the UV rects.
+    void pack() {
+        auto start = std::chrono::steady_clock::now();
+
+        Entry white;
+        white.name = "white";
+        white.width = white.height = kWhiteSize;
+        white.pixels.assign(kWhiteSize * kWhiteSize * 4, 255);
+        entries.push_back(std::move(white));
+
+        std::vector<size_t> order(entries.size());
+        for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return entries[a].height > entries[b].height;
+        });
+
+        size = 64;
+        while (!tryPack(order)) size *= 2;
+
+        pixels.assign(static_cast<size_t>(size) * size * 4, 0);
+        for (auto& e : entries) {
+            for (int y = 0; y < e.height; ++y) {
+                std::memcpy(&pixels[(static_cast<size_t>(e.y + y) * size + e.x) * 4],
+                            &e.pixels[static_cast<size_t>(y) * e.width * 4], static_cast<size_t>(e.width) * 4);
+            }
+            // Sample the white block at its center so filtering never
+            // reaches a neighbour.
+            float inset = e.name == "white" ? kWhiteSize / 2.0f - 0.5f : 0.0f;
+            e.uv = { (e.x + inset) / size, (e.y + inset) / size,
+                     (e.x + e.width - inset) / size, (e.y + e.height - inset) / size };
+            e.pixels.clear();
+            e.pixels.shrink_to_fit();
+        }
+
+        packSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Creates the GL texture; needs a current context. Pixels are dropped
+    // once uploaded.
+    GLuint upload() {
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, size, size, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+        glBindTexture(GL_TEXTURE_2D, 0);
+        pixels.clear();
+        pixels.shrink_to_fit();
+        return texture;
+    }
+
+    // Deletes the texture; needs the context upload() ran under.
+    void release() {
+        if (!texture) return;
+        glDeleteTextures(1, &texture);
+        texture = 0;
+    }
+
+    const UvRect* find(const std::string& name) const {
+        for (const auto& e : entries) {
+            if (e.name == name) return &e.uv;
+        }
+        return nullptr;
+    }
+
+    const UvRect& white() const { return *find("white"); }
+
+    GLuint texture = 0;
+    int size = 0;
+    double decodeSeconds = 0.0;
+    double packSeconds = 0.0;
+
+private:
+    struct Entry {
+        std::string name;
+        int width = 0, height = 0;
+        int x = 0, y = 0;
+        std::vector<unsigned char> pixels;
+        UvRect uv = {};
+    };
+
+    bool tryPack(const std::vector<size_t>& order) {
+        int shelfX = 0, shelfY = 0, shelfHeight = 0;
+        for (size_t i : order) {
+            Entry& e = entries[i];
+            int w = e.width + kPadding * 2, h = e.height + kPadding * 2;
+            if (w > size) return false;
+            if (shelfX + w > size) {
+                shelfY += shelfHeight;
+                shelfX = 0;
+                shelfHeight = 0;
+            }
+            if (shelfY + h > size) return false;
+            e.x = shelfX + kPadding;
+            e.y = shelfY + kPadding;
+            shelfX += w;
+            shelfHeight = std::max(shelfHeight, h);
+        }
+        return true;
+    }
+
+    std::vector<Entry> entries;
+    std::vector<unsigned char> pixels;
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Lock-free hand-off of the latest value from one writer thread to one reader
+// thread. There are three slots: the writer fills its back slot and swaps it
+// into the middle; the reader swaps the middle out when it is newer than its
+// front slot. Neither side ever waits, the writer never overwrites what the
+// reader holds, and the reader always sees a complete value. Intermediate
+// values the reader was too slow to see are skipped.
+//
+// Slots are reused, so a T whose copy reuses capacity (vectors) stops
+// allocating once every slot has held the largest value.
+template <typename T>
+class TripleBuffer {
+public:
+    // Writer side: fill back(), then publish() it.
+    T& back() { return slots[backIndex]; }
+
+    void publish() {
+        backIndex = middle.exchange(static_cast<uint8_t>(backIndex | kFresh), std::memory_order_acq_rel) & kIndexMask;
+    }
+
+    // Reader side: picks up the newest published value, if any, and returns
+    // whether front() changed.
+    bool update() {
+        if (!(middle.load(std::memory_order_relaxed) & kFresh)) return false;
+        frontIndex = middle.exchange(frontIndex, std::memory_order_acq_rel) & kIndexMask;
+        return true;
+    }
+
+    const T& front() const { return slots[frontIndex]; }
+
+private:
+    static constexpr uint8_t kIndexMask = 0x03;
+    static constexpr uint8_t kFresh = 0x04;
+
+    T slots[3];
+    // Writer and reader indices on separate cache lines from the shared one.
+    alignas(64) uint8_t backIndex = 0;
+    alignas(64) std::atomic<uint8_t> middle{ 1 };
+    alignas(64) uint8_t frontIndex = 2;
+};
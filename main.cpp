@@ -5,140 +5,106 @@
 #include <ctime>
 #include <iostream>
 #include <algorithm>
-#include <sstream>
 #include <limits>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+
+#include <atomic>
+#include <thread>
+
+#define ALLOC_COUNTER_IMPLEMENTATION
+#include "include/alloc_counter.h"
+#define STB_IMAGE_IMPLEMENTATION
+#include "include/game_world.h"
+#include "include/bench_stats.h"
+#include "include/fixed_step.h"
+#include "include/run_farm.h"
+#include "include/level_validator.h"
+#include "include/ecs_systems.h"
+#include "include/landing_kernel.h"
+#include "include/sprite_batch.h"
+#include "include/instanced_renderer.h"
+#include "include/texture_atlas.h"
+#include "include/hud_text.h"
+#include "include/frame_profiler.h"
+#include "include/triple_buffer.h"
 
 int windowWidth = 400;
 int windowHeight = 600;
 
-float playerX = windowWidth / 2.0f;
-float playerY = windowHeight / 5.0f;
-float playerWidth = 50.0f;
-float playerHeight = 60.0f;
-float playerVelX = 0.0f;
-float playerVelY = 0.0f;
-float moveSpeed = 4.0f;
-float gravity = 0.3f;
-float jumpStrength = 10.0f;
-float boostedJumpStrength = 18.0f;
-bool hasBoost = false;
-int boostDuration = 300;
-int boostTimer = 0;
-
-void drawRect(float x, float y, float width, float height);
-
-class Platform {
-public:
-    float x, y;
-    float width = 60.0f;
-    float height = 10.0f;
-    bool moving = false;
-    float velX = 2.0f;
-    bool breakable = false;
-    bool broken = false;
-
-    Platform(float startX, float startY, bool isMoving = false, bool isBreakable = false)
-        : x(startX), y(startY), moving(isMoving), breakable(isBreakable) {}
-
-    void draw() const {
-        if (broken) return;
-        if (breakable) glColor3f(0.8f, 0.5f, 0.5f);
-        else if (moving) glColor3f(0.4f, 0.4f, 0.9f);
-        else glColor3f(0.5f, 0.25f, 0.0f);
-        drawRect(x, y, width, height);
-    }
-
-    void update() {
-        if (moving && !broken) {
-            x += velX;
-            if (x < width / 2 || x > windowWidth - width / 2) {
-                velX *= -1;
-            }
-        }
-    }
-};
-
-class Collectible {
-public:
-    float x, y;
-    float size;
-    bool active = true;
-
-    Collectible(float startX, float startY, float itemSize)
-        : x(startX), y(startY), size(itemSize) {}
-
-    virtual ~Collectible() = default;
-
-    virtual void draw() const = 0;
-
-    bool checkCollision(float pX, float pY, float pWidth, float pHeight) {
-        if (!active) return false;
+enum GameState { MENU, PLAYING, GAME_OVER };
 
-        bool xOverlap = pX + pWidth / 2 > x - size / 2 &&
-                        pX - pWidth / 2 < x + size / 2;
-        bool yOverlap = pY + pHeight / 2 > y - size / 2 &&
-                        pY - pHeight / 2 < y + size / 2;
-        
-        if (xOverlap && yOverlap) {
-            active = false;
-            return true;
-        }
-        return false;
-    }
-    
-    virtual void applyEffect() = 0;
+struct ViewState {
+    float playerX, playerY, cameraY;
 };
 
-class Coin : public Collectible {
-public:
-    Coin(float startX, float startY) : Collectible(startX, startY, 15.0f) {}
-
-    void draw() const override {
-        if (!active) return;
-        glColor3f(1.0f, 0.84f, 0.0f);
-        drawRect(x, y, size, size);
-    }
-
-    void applyEffect() override {
-        extern int coinsCollected;
-        coinsCollected++;
-    }
+const double kTickSeconds = 0.016;
+
+// Everything a frame draws, copied out of the simulation after each batch of
+// ticks. Once published it is never written again until the render thread
+// has let go of it.
+struct WorldSnapshot {
+    GameWorld world;
+    GameState state = MENU;
+    int highScore = 0;
+    // The last two ticks, and how far into the next one the simulation was
+    // when it published; frames extrapolate alpha from there.
+    ViewState prevView = {};
+    ViewState currView = {};
+    float alpha = 0.0f;
+    std::chrono::steady_clock::time_point publishedAt;
+    // The simulation thread's profiler phases, for the overlay.
+    PhaseSummary simPhases[PHASE_COUNT];
 };
 
-class HighJumpPowerUp : public Collectible {
-public:
-    HighJumpPowerUp(float startX, float startY) : Collectible(startX, startY, 20.0f) {}
-
-    void draw() const override {
-        if (!active) return;
-        glColor3f(0.2f, 0.2f, 1.0f);
-        drawRect(x, y, size, size);
-    }
-
-    void applyEffect() override {
-        extern bool hasBoost;
-        extern int boostTimer;
-        extern int boostDuration;
-        hasBoost = true;
-        boostTimer = boostDuration;
-    }
-};
-
-
-std::vector<Platform> platforms;
-std::vector<Coin> coins;
-std::vector<HighJumpPowerUp> highJumpPowerUps;
-
-int initialPlatforms = 10;
-float platformSpacing = 80.0f;
-
-float cameraY = 0.0f;
-int score = 0;
+// Simulation thread only. The simulation ticks at a fixed 16 ms.
+GameWorld world;
+PlayerInput input;
 int highScore = 0;
-int coinsCollected = 0;
-
-enum GameState { MENU, PLAYING, GAME_OVER };
+uint64_t gameSeed = 0;
 GameState gameState = MENU;
+FixedStepClock stepClock(kTickSeconds, 5);
+ViewState prevView = {};
+ViewState currView = {};
+
+// Shared between the threads, all lock-free. Keys become commands the
+// simulation applies at its next tick; the held direction is read every tick.
+enum SimCommand { CMD_NONE, CMD_START, CMD_RESTART, CMD_MENU };
+TripleBuffer<WorldSnapshot> snapshots;
+std::atomic<int> pendingCommand{ CMD_NONE };
+std::atomic<int> heldMoveDir{ 0 };
+std::atomic<int> resetWidth{ 400 }; // window size for the next reset
+std::atomic<int> resetHeight{ 600 };
+std::atomic<bool> simRunning{ false };
+std::thread simThread;
+ChunkStreamer chunkStreamer; // feeds the simulation thread's world
+AllocationCounts simStartAllocations;
+
+// GL thread only: the snapshot being drawn.
+const WorldSnapshot* shown = &snapshots.front();
+
+ViewState captureView() {
+    const Position& player = world.playerPosition();
+    return { player.x, player.y, world.cameraY };
+}
+
+float snapshotAlpha(const WorldSnapshot& s) {
+    double since = std::chrono::duration<double>(std::chrono::steady_clock::now() - s.publishedAt).count();
+    return static_cast<float>(std::min(1.0, s.alpha + since / kTickSeconds));
+}
+
+ViewState interpolatedView(const WorldSnapshot& s, float alpha) {
+    ViewState v;
+    const ViewState& prev = s.prevView;
+    const ViewState& curr = s.currView;
+    float dx = curr.playerX - prev.playerX;
+    // Don't sweep the player across the screen when it wraps around an edge.
+    v.playerX = std::fabs(dx) > s.world.width / 2.0f ? curr.playerX : prev.playerX + dx * alpha;
+    v.playerY = prev.playerY + (curr.playerY - prev.playerY) * alpha;
+    v.cameraY = prev.cameraY + (curr.cameraY - prev.cameraY) * alpha;
+    return v;
+}
 
 void drawRect(float x, float y, float width, float height) {
     glBegin(GL_QUADS);
@@ -149,195 +115,383 @@ void drawRect(float x, float y, float width, float height) {
     glEnd();
 }
 
-void renderBitmapString(float x, float y, void* font, const char* string) {
-    glRasterPos2f(x, y);
-    while (*string) {
-        glutBitmapCharacter(font, *string);
-        ++string;
+const Color kPlayerColor = { 0.9f, 0.1f, 0.1f };
+const Color kCoinColor = { 1.0f, 0.84f, 0.0f };
+const Color kPowerUpColor = { 0.2f, 0.2f, 1.0f };
+
+const Color& platformColor(PlatformType type) {
+    static const Color colors[PLATFORM_TYPE_COUNT] = {
+        { 0.5f, 0.25f, 0.0f }, // PLATFORM_NORMAL
+        { 0.4f, 0.4f, 0.9f },  // PLATFORM_MOVING
+        { 0.8f, 0.5f, 0.5f },  // PLATFORM_BREAKABLE
+    };
+    return colors[type];
+}
+
+// Logical [first, last) ranges of each y-sorted store that overlap the view.
+// Platforms are generated a spacing above the screen and only retired once
+// they are below it, so most of each store is off screen.
+struct VisibleSlices {
+    size_t platformFirst, platformLast;
+    size_t coinFirst, coinLast;
+    size_t powerUpFirst, powerUpLast;
+};
+
+// Last frame's world entities: submitted, and skipped by the view test.
+struct CullStats {
+    int drawn = 0;
+    int culled = 0;
+};
+CullStats cullStats;
+bool cullingEnabled = true; // 'c' toggles it in game
+
+// Binary-searches each store for the items whose y extent overlaps
+// (cameraY, cameraY + viewHeight). An item is past the top once its top edge
+// is more than its own height above the view.
+VisibleSlices visibleSlices(float cameraY, float viewHeight) {
+    const GameRegistry& reg = shown->world.registry;
+    const SortedView& platforms = shown->world.platforms;
+    const SortedView& coins = shown->world.collectibles.of<Coin>();
+    const SortedView& powerUps = shown->world.collectibles.of<HighJumpPowerUp>();
+
+    VisibleSlices v = { 0, platforms.size(), 0, coins.size(), 0, powerUps.size() };
+    if (cullingEnabled) {
+        float bottom = cameraY, top = cameraY + viewHeight;
+        // All platform types share one height (see landing_kernel.h).
+        v.platformFirst = firstTopAbove(reg, platforms, bottom);
+        v.platformLast = firstTopAbove(reg, platforms, top + kPlatformTypes[PLATFORM_NORMAL].height);
+        v.coinFirst = firstTopAbove(reg, coins, bottom);
+        v.coinLast = firstTopAbove(reg, coins, top + Coin::size);
+        v.powerUpFirst = firstTopAbove(reg, powerUps, bottom);
+        v.powerUpLast = firstTopAbove(reg, powerUps, top + HighJumpPowerUp::size);
     }
+
+    int drawn = 0;
+    for (size_t n = v.platformFirst; n < v.platformLast; ++n) drawn += !reg.get<PlatformComponent>(platforms[n]).broken;
+    for (size_t i = v.coinFirst; i < v.coinLast; ++i) drawn += reg.get<Collectible>(coins[i]).active;
+    for (size_t i = v.powerUpFirst; i < v.powerUpLast; ++i) drawn += reg.get<Collectible>(powerUps[i]).active;
+    cullStats.drawn = drawn + 1; // and the player
+    cullStats.culled = static_cast<int>(platforms.size() - (v.platformLast - v.platformFirst) +
+                                        coins.size() - (v.coinLast - v.coinFirst) +
+                                        powerUps.size() - (v.powerUpLast - v.powerUpFirst));
+    return v;
 }
 
-void drawPlayer() {
-    glColor3f(0.9f, 0.1f, 0.1f);
-    drawRect(playerX, playerY, playerWidth, playerHeight);
+// Immediate mode: one glBegin/glEnd per entity. Kept as the reference path
+// ('b' toggles it in game) and for the render benchmark.
+void drawPlayer(float x, float y) {
+    glColor3f(kPlayerColor.r, kPlayerColor.g, kPlayerColor.b);
+    drawRect(x, y, shown->world.playerWidth, shown->world.playerHeight);
 }
 
-void drawPlatforms() {
-    for (const auto& p : platforms) {
-        p.draw();
+void drawPlatforms(size_t first, size_t last) {
+    const GameRegistry& reg = shown->world.registry;
+    const SortedView& platforms = shown->world.platforms;
+    for (size_t n = first; n < last; ++n) {
+        const PlatformComponent& pc = reg.get<PlatformComponent>(platforms[n]);
+        if (pc.broken) continue;
+        const Position& p = reg.get<Position>(platforms[n]);
+        const Color& c = platformColor(pc.type);
+        glColor3f(c.r, c.g, c.b);
+        drawRect(p.x, p.y, kPlatformTypes[pc.type].width, kPlatformTypes[pc.type].height);
     }
 }
 
-void drawCoins() {
-    for (const auto& c : coins) {
-        c.draw();
+// Items of collectible type T in logical [first, last) of its view.
+template <typename T>
+void drawCollectibles(size_t first, size_t last, const Color& color) {
+    glColor3f(color.r, color.g, color.b);
+    const GameRegistry& reg = shown->world.registry;
+    const SortedView& items = shown->world.collectibles.of<T>();
+    for (size_t i = first; i < last; ++i) {
+        if (!reg.get<Collectible>(items[i]).active) continue;
+        const Position& p = reg.get<Position>(items[i]);
+        drawRect(p.x, p.y, T::size, T::size);
     }
 }
 
-void drawHighJumpPowerUps() {
-    for (const auto& hjpu : highJumpPowerUps) {
-        hjpu.draw();
-    }
+void drawWorldImmediate(const VisibleSlices& v, float playerX, float playerY) {
+    drawPlatforms(v.platformFirst, v.platformLast);
+    drawCollectibles<Coin>(v.coinFirst, v.coinLast, kCoinColor);
+    drawCollectibles<HighJumpPowerUp>(v.powerUpFirst, v.powerUpLast, kPowerUpColor);
+    drawPlayer(playerX, playerY);
 }
 
-void generateInitialPlatforms() {
-    platforms.clear();
-    coins.clear();
-    highJumpPowerUps.clear();
+SpriteBatch spriteBatch;
+InstancedRenderer instancedRenderer;
+TextureAtlas atlas;
+BitmapFont hudFont;
+SpriteBatch hudBatch;
+SpriteBatch profilerBatch;
+
+// The player's art in the atlas, or null to draw it as a flat quad.
+const UvRect* playerSprite = nullptr;
+const Color kSpriteTint = { 1.0f, 1.0f, 1.0f };
 
-    platforms.emplace_back(windowWidth / 2.0f, 50.0f);
-    coins.emplace_back(platforms.back().x, platforms.back().y + platforms.back().height / 2 + 7.5f + 5.0f);
+enum RenderPath { RENDER_IMMEDIATE, RENDER_BATCHED, RENDER_INSTANCED, RENDER_PATH_COUNT };
+RenderPath renderPath = RENDER_BATCHED;
 
+const char* renderPathName(RenderPath path) {
+    static const char* names[RENDER_PATH_COUNT] = { "immediate", "batched", "instanced" };
+    return names[path];
+}
 
-    float currentY = platforms[0].y + platformSpacing;
-    for (int i = 1; i < initialPlatforms; ++i) {
-        float randX = (rand() % (windowWidth - 60)) + 30;
-        bool isMoving = (rand() % 10 < 2);
-        bool isBreakable = (rand() % 10 < 2 && !isMoving);
-        
-        platforms.emplace_back(randX, currentY, isMoving, isBreakable);
-        coins.emplace_back(platforms.back().x, platforms.back().y + platforms.back().height / 2 + 7.5f + 5.0f);
+// Same scene and draw order as drawWorldImmediate, in a single draw call.
+void drawWorldBatched(const VisibleSlices& v, float playerX, float playerY) {
+    spriteBatch.begin();
+
+    const GameRegistry& reg = shown->world.registry;
+    const SortedView& platforms = shown->world.platforms;
+    for (size_t n = v.platformFirst; n < v.platformLast; ++n) {
+        const PlatformComponent& pc = reg.get<PlatformComponent>(platforms[n]);
+        if (pc.broken) continue;
+        const Position& p = reg.get<Position>(platforms[n]);
+        spriteBatch.addRect(p.x, p.y, kPlatformTypes[pc.type].width, kPlatformTypes[pc.type].height,
+                            platformColor(pc.type));
+    }
 
-        currentY += platformSpacing;
+    const SortedView& coins = shown->world.collectibles.of<Coin>();
+    for (size_t i = v.coinFirst; i < v.coinLast; ++i) {
+        if (!reg.get<Collectible>(coins[i]).active) continue;
+        const Position& p = reg.get<Position>(coins[i]);
+        spriteBatch.addRect(p.x, p.y, Coin::size, Coin::size, kCoinColor);
     }
 
-    if (initialPlatforms > 4) {
-        float randX_hj = (rand() % (windowWidth - 40)) + 20;
-        int targetPlatformIndex = rand() % (platforms.size() / 2) + (platforms.size() / 3) ;
-        float randY_hj = platforms[targetPlatformIndex].y + platforms[targetPlatformIndex].height / 2 + 10.0f + 5.0f;
-        highJumpPowerUps.emplace_back(randX_hj, randY_hj);
+    const SortedView& powerUps = shown->world.collectibles.of<HighJumpPowerUp>();
+    for (size_t i = v.powerUpFirst; i < v.powerUpLast; ++i) {
+        if (!reg.get<Collectible>(powerUps[i]).active) continue;
+        const Position& p = reg.get<Position>(powerUps[i]);
+        spriteBatch.addRect(p.x, p.y, HighJumpPowerUp::size, HighJumpPowerUp::size, kPowerUpColor);
     }
+
+    if (playerSprite) spriteBatch.addSprite(playerX, playerY, shown->world.playerWidth, shown->world.playerHeight, *playerSprite, kSpriteTint);
+    else spriteBatch.addRect(playerX, playerY, shown->world.playerWidth, shown->world.playerHeight, kPlayerColor);
+    spriteBatch.flush();
 }
 
-void generateNewPlatforms() {
-    while (platforms.empty() || platforms.back().y < cameraY + windowHeight + platformSpacing) {
-        float lastY = platforms.empty() ? cameraY - windowHeight : platforms.back().y;
-        float randX = (rand() % (windowWidth - 60)) + 30;
-        
-        bool isMoving = (rand() % 10 < 2);
-        bool isBreakable = (rand() % 10 < 2 && !isMoving);
+// Same scene again as one instanced draw: the CPU writes 12 bytes per quad
+// and sizes and colors come from the renderer's per-kind table.
+void drawWorldInstanced(const VisibleSlices& v, float playerX, float playerY, float cameraY) {
+    if (playerSprite) instancedRenderer.setKind(QUAD_PLAYER, shown->world.playerWidth, shown->world.playerHeight, kSpriteTint, *playerSprite);
+    else instancedRenderer.setKind(QUAD_PLAYER, shown->world.playerWidth, shown->world.playerHeight, kPlayerColor, atlas.white());
+    instancedRenderer.begin();
+
+    const GameRegistry& reg = shown->world.registry;
+    const SortedView& platforms = shown->world.platforms;
+    for (size_t n = v.platformFirst; n < v.platformLast; ++n) {
+        const PlatformComponent& pc = reg.get<PlatformComponent>(platforms[n]);
+        if (pc.broken) continue;
+        const Position& p = reg.get<Position>(platforms[n]);
+        instancedRenderer.add(p.x, p.y, pc.type);
+    }
 
-        platforms.emplace_back(randX, lastY + platformSpacing, isMoving, isBreakable);
-        score += 10;
+    const SortedView& coins = shown->world.collectibles.of<Coin>();
+    for (size_t i = v.coinFirst; i < v.coinLast; ++i) {
+        if (!reg.get<Collectible>(coins[i]).active) continue;
+        const Position& p = reg.get<Position>(coins[i]);
+        instancedRenderer.add(p.x, p.y, QUAD_COIN);
+    }
 
-        coins.emplace_back(platforms.back().x, platforms.back().y + platforms.back().height / 2 + 7.5f + 5.0f);
+    const SortedView& powerUps = shown->world.collectibles.of<HighJumpPowerUp>();
+    for (size_t i = v.powerUpFirst; i < v.powerUpLast; ++i) {
+        if (!reg.get<Collectible>(powerUps[i]).active) continue;
+        const Position& p = reg.get<Position>(powerUps[i]);
+        instancedRenderer.add(p.x, p.y, QUAD_POWER_UP);
+    }
+
+    instancedRenderer.add(playerX, playerY, QUAD_PLAYER);
+    instancedRenderer.flush(cameraY, windowWidth, windowHeight);
+}
 
-        if (rand() % 15 == 0) {
-            float hjpuX = (rand() % (windowWidth - 60)) + 30;
-            float hjpuY = platforms.back().y + platforms.back().height / 2 + 10.0f + (rand() % 20);
-            highJumpPowerUps.emplace_back(hjpuX, hjpuY);
+// Sprites are decoded at up to this many pixels a side; the player is drawn
+// at 50x60, so this leaves headroom for a larger window.
+const int kSpriteMaxSize = 128;
+
+// Decodes the art and packs it into the atlas both batched paths sample.
+// A missing file only costs the sprite: the player falls back to a flat quad.
+void loadAtlas() {
+    int decoded = 0;
+    if (atlas.addImage("player", "bean.png", kSpriteMaxSize)) ++decoded;
+    else std::cerr << "atlas: can't load bean.png: " << stbi_failure_reason() << std::endl;
+    BitmapFont::addGlyphs(atlas);
+    atlas.pack();
+    atlas.upload();
+    playerSprite = atlas.find("player");
+    hudFont.bind(atlas);
+
+    std::cout << "atlas: decoded " << decoded << " image(s) in " << atlas.decodeSeconds * 1000.0
+              << " ms, packed " << atlas.size << "x" << atlas.size << " in " << atlas.packSeconds * 1000.0
+              << " ms" << std::endl;
+}
+
+void initRenderers() {
+    loadAtlas();
+    spriteBatch.init();
+    spriteBatch.setAtlas(atlas);
+    hudBatch.init();
+    hudBatch.setAtlas(atlas);
+    profilerBatch.init();
+    profilerBatch.setAtlas(atlas);
+    if (instancedRenderer.init()) {
+        instancedRenderer.setAtlas(atlas.texture);
+        for (int t = 0; t < PLATFORM_TYPE_COUNT; ++t) {
+            PlatformType type = static_cast<PlatformType>(t);
+            instancedRenderer.setKind(t, kPlatformTypes[t].width, kPlatformTypes[t].height, platformColor(type), atlas.white());
         }
+        instancedRenderer.setKind(QUAD_COIN, Coin::size, Coin::size, kCoinColor, atlas.white());
+        instancedRenderer.setKind(QUAD_POWER_UP, HighJumpPowerUp::size, HighJumpPowerUp::size, kPowerUpColor, atlas.white());
+        renderPath = RENDER_INSTANCED;
     }
 }
 
-void removeOldPlatforms() {
-    platforms.erase(std::remove_if(platforms.begin(), platforms.end(),
-        [&](const Platform& p) {
-            return p.y < cameraY - p.height;
-        }), platforms.end());
-
-    coins.erase(std::remove_if(coins.begin(), coins.end(),
-        [&](const Coin& c) {
-            return !c.active || c.y < cameraY - c.size;
-        }), coins.end());
+// Frees what initRenderers() made. Must run while the window's context is
+// still current: from the close callback, or before a GL benchmark returns.
+void releaseRenderers() {
+    instancedRenderer.release();
+    profilerBatch.release();
+    hudBatch.release();
+    spriteBatch.release();
+    atlas.release();
+}
 
-    highJumpPowerUps.erase(std::remove_if(highJumpPowerUps.begin(), highJumpPowerUps.end(),
-        [&](const HighJumpPowerUp& hjpu) {
-            return !hjpu.active || hjpu.y < cameraY - hjpu.size;
-        }), highJumpPowerUps.end());
+// Expects the modelview to already translate by -cameraY for the two
+// fixed-function paths; the instanced path does its own transform. Only the
+// part of each store inside the view is submitted.
+void drawWorld(float playerX, float playerY, float cameraY) {
+    VisibleSlices v = visibleSlices(cameraY, static_cast<float>(windowHeight));
+    switch (renderPath) {
+    case RENDER_IMMEDIATE: drawWorldImmediate(v, playerX, playerY); break;
+    case RENDER_BATCHED: drawWorldBatched(v, playerX, playerY); break;
+    default: drawWorldInstanced(v, playerX, playerY, cameraY); break;
+    }
 }
 
-void resetGame() {
-    playerX = windowWidth / 2.0f;
-    playerY = windowHeight / 5.0f;
-    playerVelX = 0.0f;
-    playerVelY = 0.0f;
-    cameraY = 0.0f;
-    score = 0;
-    coinsCollected = 0;
-    hasBoost = false;
-    boostTimer = 0;
-    generateInitialPlatforms();
+// 'b' cycles through the paths this context supports.
+void nextRenderPath() {
+    int next = (renderPath + 1) % RENDER_PATH_COUNT;
+    if (next == RENDER_INSTANCED && !instancedRenderer.ready()) next = RENDER_IMMEDIATE;
+    renderPath = static_cast<RenderPath>(next);
 }
 
-void updatePlatforms() {
-    for (auto& p : platforms) {
-        p.update();
-    }
+void resetGame() {
+    world.width = resetWidth.load(std::memory_order_relaxed);
+    world.height = resetHeight.load(std::memory_order_relaxed);
+    world.reset(gameSeed++);
+    input = PlayerInput();
+    heldMoveDir.store(0, std::memory_order_relaxed);
+    currView = prevView = captureView();
 }
 
 void update() {
     if (gameState != PLAYING) return;
 
-    playerVelY -= gravity;
-    playerY += playerVelY;
-    playerX += playerVelX;
-
-    if (playerX > windowWidth + playerWidth / 2) playerX = -playerWidth / 2;
-    else if (playerX < -playerWidth / 2) playerX = windowWidth + playerWidth / 2;
-
-    updatePlatforms();
-
-    if (playerVelY < 0) {
-        for (auto& p : platforms) {
-            if (p.broken) continue;
+    prevView = currView;
+    input.moveDir = heldMoveDir.load(std::memory_order_relaxed);
+    world.step(input);
+    currView = captureView();
+}
 
-            bool xOverlap = playerX + playerWidth / 2 > p.x - p.width / 2 &&
-                            playerX - playerWidth / 2 < p.x + p.width / 2;
+// Simulation thread: the front end's reaction to the end of a game.
+// `context` is the world that raised the events.
+void onWorldEvents(void* context, const GameEvent* events, int count) {
+    const GameWorld& source = *static_cast<const GameWorld*>(context);
+    for (int i = 0; i < count; ++i) {
+        if (events[i].type != EVENT_GAME_OVER) continue;
+        gameState = GAME_OVER;
+        if (source.score > highScore) highScore = source.score;
+        std::cout << "Game Over! Final Score: " << source.score << std::endl;
+    }
+}
 
-            if (xOverlap) { 
-                float player_bottom_current = playerY - playerHeight / 2;
-                float player_bottom_previous = (playerY - playerVelY) - playerHeight / 2;
-                float platform_top_surface = p.y + p.height / 2;
+// Every event the simulation raised, for the exit dump.
+EventCounts simEventCounts;
 
-                if (player_bottom_previous >= platform_top_surface &&
-                    player_bottom_current < platform_top_surface) {    
-                    
-                    playerY = platform_top_surface + playerHeight / 2;
-                    playerVelY = hasBoost ? boostedJumpStrength : jumpStrength;
-                    if (p.breakable) p.broken = true;
-                    break; 
-                }
-            }
-        }
+// Applies a key press from the GL thread against the simulation's own state.
+// Returns whether anything changed.
+bool applyCommand(int command) {
+    if ((command == CMD_START && gameState == MENU) || (command == CMD_RESTART && gameState == GAME_OVER)) {
+        resetGame();
+        gameState = PLAYING;
+        return true;
     }
-
-    for (auto& c : coins) {
-        if (c.checkCollision(playerX, playerY, playerWidth, playerHeight)) {
-            c.applyEffect();
-        }
+    if (command == CMD_MENU && gameState != MENU) {
+        gameState = MENU;
+        heldMoveDir.store(0, std::memory_order_relaxed); // Stop horizontal movement when returning to menu
+        return true;
     }
+    return false;
+}
 
-    for (auto& hjpu : highJumpPowerUps) {
-        if (hjpu.checkCollision(playerX, playerY, playerWidth, playerHeight)) {
-            hjpu.applyEffect();
-        }
+// Copies the world into the back slot and hands it to the render thread.
+// Slots keep their vectors' capacity, so this stops allocating once the
+// world has reached its usual size.
+void publishSnapshot() {
+    static PhaseSummary simPhases[PHASE_COUNT];
+    static std::chrono::steady_clock::time_point summarized;
+
+    auto now = std::chrono::steady_clock::now();
+    if (now - summarized > std::chrono::milliseconds(250)) {
+        summarized = now;
+        for (int p = 0; p < PHASE_COUNT; ++p) simPhases[p] = frameProfiler().history(p).summary();
     }
 
+    WorldSnapshot& s = snapshots.back();
+    s.world = world;
+    s.state = gameState;
+    s.highScore = highScore;
+    s.prevView = prevView;
+    s.currView = currView;
+    s.alpha = stepClock.alpha();
+    s.publishedAt = now;
+    std::copy(simPhases, simPhases + PHASE_COUNT, s.simPhases);
+    snapshots.publish();
+}
 
-    if (hasBoost) {
-        boostTimer--;
-        if (boostTimer <= 0) hasBoost = false;
-    }
+// Simulation thread profile, kept after the thread exits for the exit dump.
+FrameProfiler simProfile;
+
+// The simulation thread: ticks on the fixed clock, publishes a snapshot
+// after every batch of ticks, and sleeps until the next tick is due. It
+// never waits on the GL thread.
+void simulationLoop() {
+#if FRAME_PROFILER
+    frameProfiler().enabled = true;
+#endif
+    stepClock.restart();
+    publishSnapshot();
+    while (simRunning.load(std::memory_order_relaxed)) {
+        bool changed = applyCommand(pendingCommand.exchange(CMD_NONE, std::memory_order_relaxed));
+        int due = stepClock.beginBatch();
+        for (int i = 0; i < due; ++i) {
+            stepClock.tick();
+            update();
+        }
+        if (due > 0 || changed) publishSnapshot();
 
-    if (playerY > cameraY + windowHeight / 2.0f) {
-        cameraY = playerY - windowHeight / 2.0f;
+        double wait = stepClock.secondsUntilNextTick();
+        if (wait > 0.0) std::this_thread::sleep_for(std::chrono::duration<double>(wait));
     }
+    simProfile = frameProfiler();
+}
 
-    generateNewPlatforms();
-    removeOldPlatforms();
-
-    if (playerY < cameraY - playerHeight) {
-        gameState = GAME_OVER;
-        if (score > highScore) highScore = score;
-        std::cout << "Game Over! Final Score: " << score << std::endl;
-    }
+void startSimulation() {
+    simStartAllocations = allocationCounts();
+    world.streamer = &chunkStreamer;
+    world.events.subscribe(onWorldEvents, &world);
+    world.events.subscribe(EventCounts::handle, &simEventCounts);
+    chunkStreamer.start(world.platformsPerChunk);
+    simRunning = true;
+    simThread = std::thread(simulationLoop);
+}
 
-    glutPostRedisplay();
+void stopSimulation() {
+    simRunning = false;
+    if (simThread.joinable()) simThread.join();
+    chunkStreamer.stop();
 }
 
 void setBackgroundColorByScore() {
-    int stage = score / 100;
+    int stage = shown->world.score / 100;
     switch (stage % 4) {
     case 0: glClearColor(0.8f, 0.9f, 1.0f, 1.0f); break;
     case 1: glClearColor(0.9f, 0.8f, 0.9f, 1.0f); break;
@@ -346,97 +500,165 @@ void setBackgroundColorByScore() {
     }
 }
 
-void display() {
-    setBackgroundColorByScore();
-    glClear(GL_COLOR_BUFFER_BIT);
-    glLoadIdentity();
+// Everything the HUD text depends on. The text is re-tessellated only when
+// this changes; other frames redraw the cached quads with one draw call.
+struct HudKey {
+    GameState state;
+    int score, coins, highScore;
+    int width, height;
 
-    if (gameState == MENU) {
-        glColor3f(0.2f, 0.6f, 1.0f);
-        renderBitmapString(windowWidth / 2 - 80, windowHeight / 2 + 20, GLUT_BITMAP_HELVETICA_18, "Simple Jump Game");
-        glColor3f(0.0f, 0.0f, 0.0f);
-        renderBitmapString(windowWidth / 2 - 100, windowHeight / 2 - 20, GLUT_BITMAP_HELVETICA_18, "Press SPACE to Start");
-    }
-    else if (gameState == GAME_OVER) {
-        glColor3f(0.8f, 0.1f, 0.1f);
-        renderBitmapString(windowWidth / 2 - 60, windowHeight / 2 + 20, GLUT_BITMAP_HELVETICA_18, "Game Over!");
-        std::stringstream ss;
-        ss << "Final Score: " << score;
-        renderBitmapString(windowWidth / 2 - 70, windowHeight / 2 - 10, GLUT_BITMAP_HELVETICA_18, ss.str().c_str());
-        ss.str(""); ss.clear();
-        ss << "High Score: " << highScore;
-        renderBitmapString(windowWidth / 2 - 70, windowHeight / 2 - 30, GLUT_BITMAP_HELVETICA_18, ss.str().c_str());
-        glColor3f(0.0f, 0.0f, 0.0f);
-        renderBitmapString(windowWidth / 2 - 90, windowHeight / 2 - 50, GLUT_BITMAP_HELVETICA_18, "Press R to Restart");
-    }
-    else if (gameState == PLAYING) {
-        glPushMatrix();
-        glMatrixMode(GL_PROJECTION);
-        glPushMatrix();
-        glLoadIdentity();
-        gluOrtho2D(0, windowWidth, 0, windowHeight);
-        glMatrixMode(GL_MODELVIEW);
-        glLoadIdentity();
+    bool operator==(const HudKey& o) const {
+        return state == o.state && score == o.score && coins == o.coins &&
+               highScore == o.highScore && width == o.width && height == o.height;
+    }
+};
+HudKey hudKey = {};
+bool hudBuilt = false;
+
+const Color kTitleColor = { 0.2f, 0.6f, 1.0f };
+const Color kTextColor = { 0.0f, 0.0f, 0.0f };
+const Color kGameOverColor = { 0.8f, 0.1f, 0.1f };
 
-        glColor3f(0.0f, 0.0f, 0.0f);
-        std::stringstream ss;
-        ss << "Score: " << score;
-        renderBitmapString(10.0f, windowHeight - 20.0f, GLUT_BITMAP_HELVETICA_18, ss.str().c_str());
+void addCenteredText(const char* text, float y, const Color& color) {
+    hudFont.addText(hudBatch, windowWidth / 2 - BitmapFont::textWidth(text) / 2, y, text, color);
+}
 
-        std::stringstream coin_ss;
-        coin_ss << "Coins: " << coinsCollected;
-        renderBitmapString(10.0f, windowHeight - 40.0f, GLUT_BITMAP_HELVETICA_18, coin_ss.str().c_str());
+void buildHud() {
+    TextBuffer<32> line;
+    hudBatch.begin();
+    if (shown->state == MENU) {
+        addCenteredText("Simple Jump Game", windowHeight / 2 + 20, kTitleColor);
+        addCenteredText("Press SPACE to Start", windowHeight / 2 - 20, kTextColor);
+    }
+    else if (shown->state == GAME_OVER) {
+        addCenteredText("Game Over!", windowHeight / 2 + 20, kGameOverColor);
+        addCenteredText(line.clear().append("Final Score: ").append(shown->world.score).c_str(), windowHeight / 2 - 10, kGameOverColor);
+        addCenteredText(line.clear().append("High Score: ").append(shown->highScore).c_str(), windowHeight / 2 - 30, kGameOverColor);
+        addCenteredText("Press R to Restart", windowHeight / 2 - 50, kTextColor);
+    }
+    else if (shown->state == PLAYING) {
+        hudFont.addText(hudBatch, 10.0f, windowHeight - 20.0f, line.clear().append("Score: ").append(shown->world.score).c_str(), kTextColor);
+        hudFont.addText(hudBatch, 10.0f, windowHeight - 40.0f, line.clear().append("Coins: ").append(shown->world.coinsCollected).c_str(), kTextColor);
+    }
+}
 
+// Expects an identity modelview over reshape()'s window-sized ortho.
+void drawHud() {
+    HudKey key = { shown->state, shown->world.score, shown->world.coinsCollected, shown->highScore, windowWidth, windowHeight };
+    if (!hudBuilt || !(key == hudKey)) {
+        hudKey = key;
+        hudBuilt = true;
+        buildHud();
+    }
+    hudBatch.flush();
+}
 
-        glMatrixMode(GL_PROJECTION);
-        glPopMatrix();
-        glMatrixMode(GL_MODELVIEW);
-        glPopMatrix();
+// Per-phase timings in the bottom-left corner ('p' toggles it). Refreshed a
+// few times a second so the numbers stay readable.
+bool profilerOverlay = false;
+std::chrono::steady_clock::time_point profilerOverlayBuilt;
+
+void buildProfilerOverlay() {
+    const float columns[4] = { 10.0f, 130.0f, 210.0f, 290.0f };
+    const char* headings[4] = { "us", "min", "avg", "p99" };
+    TextBuffer<16> cell;
+    profilerBatch.begin();
+    float y = 10.0f + PHASE_COUNT * 18.0f;
+    for (int c = 0; c < 4; ++c) hudFont.addText(profilerBatch, columns[c], y, headings[c], kTextColor);
+    for (int p = 0; p < PHASE_COUNT; ++p) {
+        y -= 18.0f;
+        // Phases this thread never times come from the simulation thread.
+        const PhaseHistory& local = frameProfiler().history(p);
+        PhaseSummary s = local.count ? local.summary() : shown->simPhases[p];
+        hudFont.addText(profilerBatch, columns[0], y, profilePhaseName(p), kTextColor);
+        hudFont.addText(profilerBatch, columns[1], y, cell.clear().appendFixed(s.min, 1).c_str(), kTextColor);
+        hudFont.addText(profilerBatch, columns[2], y, cell.clear().appendFixed(s.avg, 1).c_str(), kTextColor);
+        hudFont.addText(profilerBatch, columns[3], y, cell.clear().appendFixed(s.p99, 1).c_str(), kTextColor);
+    }
+}
 
-        glTranslatef(0.0f, -cameraY, 0.0f);
-        drawPlatforms();
-        drawCoins();
-        drawHighJumpPowerUps();
-        drawPlayer();
+void drawProfilerOverlay() {
+    auto now = std::chrono::steady_clock::now();
+    if (now - profilerOverlayBuilt > std::chrono::milliseconds(250)) {
+        profilerOverlayBuilt = now;
+        buildProfilerOverlay();
     }
+    profilerBatch.flush();
+}
+
+// Frames presented on the GL thread, and how many of them showed a snapshot
+// the previous frame hadn't; ticks are counted by the simulation's clock.
+struct RenderRateStats {
+    long long frames = 0;
+    long long freshFrames = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+};
+RenderRateStats renderRate;
+// Set when idle() picks up a snapshot the screen hasn't shown yet.
+bool freshPending = false;
 
+void display() {
+    setBackgroundColorByScore();
+    glClear(GL_COLOR_BUFFER_BIT);
+    glLoadIdentity();
+
+    {
+        PROFILE_PHASE(PHASE_DRAW);
+        drawHud();
+        if (shown->state == PLAYING) {
+            ViewState view = interpolatedView(*shown, snapshotAlpha(*shown));
+            glTranslatef(0.0f, -view.cameraY, 0.0f);
+            drawWorld(view.playerX, view.playerY, view.cameraY);
+        }
+    }
+
+    if (profilerOverlay) {
+        glLoadIdentity();
+        drawProfilerOverlay();
+    }
+
+    PROFILE_PHASE(PHASE_SWAP);
     glutSwapBuffers();
+    renderRate.frames++;
+    if (freshPending) renderRate.freshFrames++;
+    freshPending = false;
 }
 
+// Keys never touch the simulation directly: game-flow keys are posted as
+// commands and movement as the held direction.
 void keyboard(unsigned char key, int x, int y) {
-    if (gameState == MENU && key == 32) { // Space to start
-        resetGame();
-        gameState = PLAYING;
-    }
-    else if (gameState == GAME_OVER) {
-        if (key == 'r' || key == 'R') { // Added 'R' for convenience
-            resetGame();
-            gameState = PLAYING;
+    if (key == 32) pendingCommand.store(CMD_START); // Space to start
+    else if (key == 'r' || key == 'R') pendingCommand.store(CMD_RESTART); // Added 'R' for convenience
+    else if (key == 27) pendingCommand.store(CMD_MENU); // ESC key
+    else if (shown->state == PLAYING) {
+        if (key == 'a' || key == 'A') heldMoveDir.store(-1); // Added 'A'
+        else if (key == 'd' || key == 'D') heldMoveDir.store(1); // Added 'D'
+        else if (key == 'b' || key == 'B') {
+            nextRenderPath();
+            std::cout << "renderer: " << renderPathName(renderPath) << std::endl;
         }
-        else if (key == 27) { // ESC key
-            gameState = MENU;
+        else if (key == 'p' || key == 'P') {
+            profilerOverlay = !profilerOverlay;
         }
-    }
-    else if (gameState == PLAYING) {
-        if (key == 'a' || key == 'A') playerVelX = -moveSpeed; // Added 'A'
-        else if (key == 'd' || key == 'D') playerVelX = moveSpeed; // Added 'D'
-        else if (key == 27) { // ESC key
-            gameState = MENU;
-            playerVelX = 0.0f; // Stop horizontal movement when returning to menu
-            // playerVelY = 0.0f; // Optional: resetGame() handles this if restarting
+        else if (key == 'c' || key == 'C') {
+            cullingEnabled = !cullingEnabled;
+            std::cout << "culling: " << (cullingEnabled ? "on" : "off") << "  drawn: " << cullStats.drawn
+                      << "  culled: " << cullStats.culled << std::endl;
         }
     }
 }
 
 void keyboardUp(unsigned char key, int x, int y) {
-    if (gameState == PLAYING && (key == 'a' || key == 'd' || key == 'A' || key == 'D')) {
-        playerVelX = 0.0f;
+    if (shown->state == PLAYING && (key == 'a' || key == 'd' || key == 'A' || key == 'D')) {
+        heldMoveDir.store(0);
     }
 }
 
 void reshape(int w, int h) {
     windowWidth = w;
     windowHeight = h;
+    resetWidth.store(w);
+    resetHeight.store(h);
     glViewport(0, 0, w, h);
     glMatrixMode(GL_PROJECTION);
     glLoadIdentity();
@@ -445,13 +667,585 @@ void reshape(int w, int h) {
     glLoadIdentity();
 }
 
-void timer(int) {
-    update();
-    glutTimerFunc(16, timer, 0);
+// GL thread only. Between ticks frames only interpolate, so redrawing more
+// often than a display refreshes burns a core for nothing: idle() sleeps out
+// the rest of each 1/120 s slot. With vsync on, the swap paces it as well.
+const std::chrono::steady_clock::duration kFrameInterval = std::chrono::microseconds(8333);
+std::chrono::steady_clock::time_point nextFrameAt;
+
+void idle() {
+    auto now = std::chrono::steady_clock::now();
+    if (now < nextFrameAt) {
+        std::this_thread::sleep_until(nextFrameAt);
+        now = nextFrameAt;
+    }
+    nextFrameAt = std::max(nextFrameAt + kFrameInterval, now);
+
+    bool fresh = snapshots.update();
+    shown = &snapshots.front();
+    if (fresh) freshPending = true;
+    // Nothing new to show and the interpolation has caught up: the last
+    // frame is still right, so don't draw it again.
+    if (fresh || snapshotAlpha(*shown) < 1.0f) glutPostRedisplay();
+}
+
+// Exit dump: how the fixed clock's batches were paced over the session.
+void printStepPacing() {
+    stepClock.stats.print(std::cout);
+}
+
+// Tick rate and frame rate, each over the same wall-clock span.
+void printRates() {
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - renderRate.start).count();
+    if (seconds <= 0.0) return;
+    std::cout << "simulation: " << stepClock.stats.ticks / seconds << " ticks/s  render: "
+              << renderRate.frames / seconds << " frames/s ("
+              << renderRate.freshFrames << " of " << renderRate.frames << " with a new snapshot)" << std::endl;
+    chunkStreamer.stats.print(std::cout);
+    simEventCounts.print(std::cout, world.events.dropped);
+    AllocationCounts heap = allocationCounts() - simStartAllocations;
+    std::cout << "heap allocations since start, all threads: " << heap.allocations
+              << " (" << heap.bytes << " bytes)" << std::endl;
+}
+
+const char* const kProfilePath = "frame_profile.csv";
+
+// The GL thread's phases plus the ones the simulation thread recorded.
+void dumpFrameProfile() {
+    FrameProfiler merged = frameProfiler();
+    merged.mergeFrom(simProfile);
+    merged.print(std::cout);
+    if (merged.writeCsv(kProfilePath)) std::cout << "profile written to " << kProfilePath << std::endl;
+    else std::cerr << "can't write " << kProfilePath << std::endl;
+}
+
+// Steps one headless world as fast as possible and reports the tick rate.
+// Restarts the world whenever the bot falls, or when a game reaches
+// kBenchMaxGameTicks, so generation stays exercised even if some layout
+// traps the bot. With `streamed`, chunks come from a ChunkStreamer worker;
+// the totals must match the inline run exactly.
+const long long kBenchMaxGameTicks = 100000;
+
+void runTickBenchmark(long long totalTicks, bool streamed) {
+    ChunkStreamer streamer;
+    GameWorld bench;
+    EventCounts eventCounts;
+    bench.events.subscribe(EventCounts::handle, &eventCounts);
+    if (streamed) {
+        streamer.start(bench.platformsPerChunk);
+        bench.streamer = &streamer;
+    }
+    uint64_t seed = 1;
+    bench.reset(seed);
+    long long games = 0;
+    long long timeouts = 0;
+    long long scoreTotal = 0;
+    long long coinTotal = 0;
+    long long narrowTests = 0;
+    long long liveCollectibles = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (long long i = 0; i < totalTicks; ++i) {
+        bench.step(chaseNextPlatform(bench));
+        narrowTests += bench.narrowPhaseTests;
+        liveCollectibles += bench.collectibles.size();
+        if (bench.gameOver || bench.ticks >= kBenchMaxGameTicks) {
+            if (!bench.gameOver) ++timeouts;
+            scoreTotal += bench.score;
+            coinTotal += bench.coinsCollected;
+            bench.reset(++seed);
+            ++games;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Same seeds and tick count must give the same totals on any build.
+    std::cout << "ticks: " << totalTicks << "  games: " << games << "  timeouts: " << timeouts
+              << "  score total: " << scoreTotal + bench.score
+              << "  coin total: " << coinTotal + bench.coinsCollected
+              << "  time: " << seconds << " s"
+              << "  ticks/sec: " << perSecond(totalTicks, seconds) << std::endl;
+    std::cout << "collectible tests/tick: " << static_cast<double>(narrowTests) / totalTicks
+              << " (of " << static_cast<double>(liveCollectibles) / totalTicks << " live)" << std::endl;
+    eventCounts.print(std::cout, bench.events.dropped);
+    if (streamed) streamer.stats.print(std::cout);
+}
+
+// Plays a `sessionSeconds` session headless at the game's tick length, as
+// fast as it runs, the way the simulation thread does: chunks from a
+// streamer and a snapshot published every tick. Counts heap allocations on
+// all threads. The first game warms the worker's chunk buffers and the
+// snapshot slots; after it, restarts included, the count should stay at 0.
+void runAllocationSoak(double sessionSeconds) {
+    static TripleBuffer<WorldSnapshot> soakSnapshots;
+    ChunkStreamer streamer;
+    GameWorld soak;
+    streamer.start(soak.platformsPerChunk);
+    soak.streamer = &streamer;
+
+    AllocationCounts start = allocationCounts();
+    uint64_t seed = 1;
+    soak.reset(seed);
+    AllocationCounts afterReset = allocationCounts();
+    AllocationCounts afterFirstGame;
+
+    long long ticks = static_cast<long long>(sessionSeconds / kTickSeconds);
+    long long games = 0;
+    for (long long i = 0; i < ticks; ++i) {
+        soak.step(chaseNextPlatform(soak));
+        soakSnapshots.back().world = soak;
+        soakSnapshots.publish();
+        soakSnapshots.update();
+        if (soak.gameOver) {
+            if (games++ == 0) afterFirstGame = allocationCounts();
+            soak.reset(++seed);
+        }
+    }
+    streamer.stop();
+    AllocationCounts end = allocationCounts();
+
+    AllocationCounts reset = afterReset - start;
+    std::cout << "session: " << sessionSeconds << " s (" << ticks << " ticks)  games: " << games << std::endl;
+    std::cout << "heap allocations  first reset: " << reset.allocations << " (" << reset.bytes << " bytes)";
+    if (games == 0) {
+        // Still warming up: there is no steady state to report yet.
+        AllocationCounts session = end - afterReset;
+        std::cout << "  session: " << session.allocations << " (" << session.bytes << " bytes)"
+                  << "  no game completed" << std::endl;
+    }
+    else {
+        AllocationCounts firstGame = afterFirstGame - afterReset;
+        AllocationCounts steady = end - afterFirstGame;
+        std::cout << "  first game: " << firstGame.allocations << " (" << firstGame.bytes << " bytes)"
+                  << "  after first game: " << steady.allocations << " (" << steady.bytes << " bytes)" << std::endl;
+    }
+    streamer.stats.print(std::cout);
+}
+
+// The platform record as it was before PlatformStore, kept only so the layout
+// benchmark can compare against it.
+struct AosPlatform {
+    float x, y;
+    float width = 60.0f;
+    float height = 10.0f;
+    bool moving = false;
+    float velX = 2.0f;
+    bool breakable = false;
+    bool broken = false;
+};
+
+// Times one tick's worth of platform work (move the moving ones, then a
+// landing sweep that misses every platform, the common case) for the old
+// array-of-structs vector against PlatformStore at 10^3..10^6 platforms.
+void runPlatformLayoutBenchmark() {
+    const int worldWidth = 400;
+    for (int n = 1000; n <= 1000000; n *= 10) {
+        Pcg32 rng(n);
+        std::vector<AosPlatform> aos;
+        PlatformStore soa;
+        for (int i = 0; i < n; ++i) {
+            float x = rng.below(worldWidth - 60) + 30;
+            float y = 50.0f + i * 80.0f;
+            int roll = rng.below(10);
+            AosPlatform p;
+            p.x = x;
+            p.y = y;
+            p.moving = roll < 2;
+            p.breakable = roll >= 8;
+            aos.push_back(p);
+            soa.add(x, y, p.moving ? PLATFORM_MOVING : p.breakable ? PLATFORM_BREAKABLE : PLATFORM_NORMAL);
+        }
+
+        // Player far above everything, so the sweep never exits early.
+        const float playerX = 200.0f, playerWidth = 50.0f;
+        const float bottomPrevious = 1e9f, bottomCurrent = 1e9f - 5.0f;
+        const int reps = std::max(1, 20000000 / n);
+        long long hits = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < reps; ++r) {
+            for (auto& p : aos) {
+                if (p.moving && !p.broken) {
+                    p.x += p.velX;
+                    if (p.x < p.width / 2 || p.x > worldWidth - p.width / 2) p.velX *= -1;
+                }
+            }
+            for (const auto& p : aos) {
+                if (p.broken) continue;
+                if (playerX + playerWidth / 2 > p.x - p.width / 2 &&
+                    playerX - playerWidth / 2 < p.x + p.width / 2 &&
+                    bottomPrevious >= p.y + p.height / 2 && bottomCurrent < p.y + p.height / 2) {
+                    ++hits;
+                    break;
+                }
+            }
+        }
+        double aosSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        for (int r = 0; r < reps; ++r) {
+            soa.update(worldWidth);
+            LandingQuery query = { playerX - playerWidth / 2, playerX + playerWidth / 2, bottomPrevious, bottomCurrent };
+            if (findLandingScalar(soa.x.data(), soa.y.data(), soa.flags.data(), 0, n, query) >= 0) ++hits;
+        }
+        double soaSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        double perTick = 1e9 / reps;
+        std::cout << "platforms: " << n
+                  << "  aos: " << aosSeconds * perTick / n << " ns/platform"
+                  << "  soa: " << soaSeconds * perTick / n << " ns/platform"
+                  << "  speedup: " << aosSeconds / soaSeconds
+                  << (hits ? "  (unexpected hit)" : "") << std::endl;
+    }
+}
+
+// Fills `world` with `count` entities spread over one screen: 60% platforms,
+// 35% coins, 5% power-ups.
+void fillRenderBenchWorld(int count) {
+    static WorldSnapshot bench;
+    bench.state = PLAYING;
+    shown = &bench;
+    GameWorld& world = bench.world;
+    world.width = windowWidth;
+    world.height = windowHeight;
+    world.reset(1);
+    world.clearLevel();
+    Pcg32 rng(static_cast<uint64_t>(count));
+    std::vector<float> ys;
+    for (int i = 0; i < count; ++i) ys.push_back(static_cast<float>(rng.below(windowHeight)));
+    std::sort(ys.begin(), ys.end());
+    for (int i = 0; i < count; ++i) {
+        float x = static_cast<float>(rng.below(windowWidth));
+        int kind = rng.below(100);
+        if (kind < 60) world.spawnPlatform(x, ys[i], static_cast<PlatformType>(rng.below(3)));
+        else if (kind < 95) world.spawnCollectible<Coin>(x, ys[i]);
+        else world.spawnCollectible<HighJumpPowerUp>(x, ys[i]);
+    }
+}
+
+// Frame time against entity count for each render path. glFinish() at the
+// end of each frame so the timing includes the driver's work, not just the
+// submission; on Mesa llvmpipe (LIBGL_ALWAYS_SOFTWARE=1) that's rasterization
+// too.
+void runRenderBenchmark() {
+    std::cout << "GL_RENDERER: " << glGetString(GL_RENDERER)
+              << "  GL_VERSION: " << glGetString(GL_VERSION)
+              << "  batch path: " << (spriteBatch.usingVbo() ? "VBO" : "client array")
+              << "  instancing: " << (instancedRenderer.ready() ? "yes" : "no") << std::endl;
+
+    const int pathCount = instancedRenderer.ready() ? RENDER_PATH_COUNT : RENDER_INSTANCED;
+    for (int count = 100; count <= 100000; count *= 10) {
+        fillRenderBenchWorld(count);
+        const int frames = std::max(10, 2000000 / (count * 10));
+        std::cout << "entities: " << count;
+        for (int path = 0; path < pathCount; ++path) {
+            renderPath = static_cast<RenderPath>(path);
+            auto start = std::chrono::steady_clock::now();
+            for (int f = 0; f < frames; ++f) {
+                glClear(GL_COLOR_BUFFER_BIT);
+                drawWorld(windowWidth / 2.0f, windowHeight / 2.0f, 0.0f);
+                glFinish();
+            }
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::cout << "  " << renderPathName(renderPath) << ": " << seconds / frames * 1000.0 << " ms/frame";
+        }
+        std::cout << "  drawn: " << cullStats.drawn << "  culled: " << cullStats.culled << std::endl;
+    }
+    renderPath = instancedRenderer.ready() ? RENDER_INSTANCED : RENDER_BATCHED;
+}
+
+typedef int (*LandingKernelFn)(const float*, const float*, const uint8_t*, int, int, const LandingQuery&);
+
+// Checks every compiled landing kernel against the scalar loop on random
+// sweeps (hits anywhere, broken platforms, empty ranges, odd tails), then
+// times each one on a sweep that has to read the whole array.
+void runLandingBenchmark() {
+    struct Kernel { const char* name; LandingKernelFn fn; };
+    std::vector<Kernel> kernels = { { "scalar", findLandingScalar } };
+#if LANDING_KERNEL_SSE2
+    kernels.push_back({ "sse2", findLandingSse2 });
+#endif
+#if LANDING_KERNEL_AVX2
+    kernels.push_back({ "avx2", findLandingAvx2 });
+#endif
+
+    std::cout << "landing kernel: " << landingKernelName() << std::endl;
+
+    Pcg32 rng(7);
+    long long mismatches = 0;
+    for (int trial = 0; trial < 200000; ++trial) {
+        int n = rng.below(70);
+        PlatformStore store;
+        for (int i = 0; i < n; ++i) {
+            store.add(static_cast<float>(rng.below(400)), 50.0f + i * 7.0f, static_cast<PlatformType>(rng.below(3)));
+            if (rng.below(4) == 0) store.setBroken(i);
+        }
+        float playerX = static_cast<float>(rng.below(400));
+        float bottomCurrent = static_cast<float>(rng.below(50 + n * 7));
+        LandingQuery q = { playerX - 25.0f, playerX + 25.0f, bottomCurrent + rng.below(40), bottomCurrent };
+        int begin = n ? rng.below(n) : 0;
+        int expected = findLandingScalar(store.x.data(), store.y.data(), store.flags.data(), begin, n, q);
+        for (const auto& k : kernels) {
+            if (k.fn(store.x.data(), store.y.data(), store.flags.data(), begin, n, q) != expected) ++mismatches;
+        }
+        int expectedAll = findLandingScalar(store.x.data(), store.y.data(), store.flags.data(), 0, n, q);
+        if (findLanding(store, q) != expectedAll) ++mismatches;
+    }
+    std::cout << "landing kernels agree with scalar: " << (mismatches ? "NO" : "yes")
+              << " (" << mismatches << " mismatches)" << std::endl;
+
+    for (int n = 1000; n <= 1000000; n *= 10) {
+        PlatformStore store;
+        for (int i = 0; i < n; ++i) {
+            store.add(static_cast<float>(rng.below(340) + 30), 50.0f + i * 80.0f, static_cast<PlatformType>(rng.below(3)));
+        }
+        LandingQuery q = { 175.0f, 225.0f, 1e9f, 1e9f - 5.0f };
+        const int reps = std::max(1, 50000000 / n);
+        std::cout << "platforms: " << n;
+        for (const auto& k : kernels) {
+            long long hits = 0;
+            auto start = std::chrono::steady_clock::now();
+            for (int r = 0; r < reps; ++r) {
+                if (k.fn(store.x.data(), store.y.data(), store.flags.data(), 0, n, q) >= 0) ++hits;
+            }
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::cout << "  " << k.name << ": " << seconds * 1e9 / reps / n << " ns/platform";
+        }
+
+        // Banded query with the player's sweep in the middle of the level.
+        long long hits = 0;
+        float mid = 50.0f + (n / 2) * 80.0f;
+        LandingQuery band = { 175.0f, 225.0f, mid + 8.0f, mid - 2.0f };
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < reps; ++r) {
+            band.bottomCurrent = mid - 2.0f - (r & 1);
+            if (findLanding(store, band) >= 0) ++hits;
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "  banded: " << seconds * 1e9 / reps << " ns/query" << std::endl;
+    }
+}
+
+// Spawns one entity of the benchmark mix at height y, above everything
+// spawned before it, through the same calls a streamed chunk uses: half
+// platforms of every type, 45% coins, 5% power-ups.
+void spawnEcsBenchEntity(GameWorld& world, Pcg32& rng, float y) {
+    float x = static_cast<float>(rng.below(340) + 30);
+    int roll = rng.below(100);
+    if (roll < 50) world.spawnPlatform(x, y, roll < 30 ? PLATFORM_NORMAL : roll < 40 ? PLATFORM_MOVING : PLATFORM_BREAKABLE);
+    else if (roll < 95) world.spawnCollectible<Coin>(x, y);
+    else world.spawnCollectible<HighJumpPowerUp>(x, y);
+}
+
+// Another player alongside the world's own, built the same way.
+void spawnEcsBenchPlayer(GameWorld& world, float x, float y) {
+    GameRegistry& reg = world.registry;
+    Entity p = reg.create();
+    if (p == kNoEntity) return;
+    reg.add<Position>(p, x, y);
+    reg.add<Velocity>(p, 0.0f, 0.0f);
+    reg.add<Gravity>(p, world.gravity);
+    reg.add<Body>(p, world.playerWidth / 2, world.playerHeight / 2);
+    reg.add<Wraps>(p);
+    reg.add<Jumper>(p, world.jumpStrength, world.boostedJumpStrength);
+    reg.add<PickupEffects>(p);
+}
+
+// Steps 10^5 mixed entities (half platforms, the rest coins and power-ups)
+// plus four players holding right through GameWorld's systems, with the
+// camera climbing so culling and respawning run each tick, and reports the
+// time per system.
+void runEcsBenchmark() {
+    const int entities = 100000;
+    const int players = 4;
+    const int ticks = 1000;
+    const float step = 2.0f;  // y between consecutive entities
+    const float climb = 2.0f; // camera rise per tick
+
+    GameWorld world;
+    world.reset(1);
+    world.clearLevel();
+    GameRegistry& reg = world.registry;
+    reg.reserve(entities + players);
+    world.platforms.reserve(entities);
+    world.collectibles.reserve(entities);
+
+    Pcg32 rng(11);
+    float topY = 0.0f;
+    for (int i = 0; i < entities; ++i) spawnEcsBenchEntity(world, rng, topY += step);
+    for (int i = 1; i < players; ++i) spawnEcsBenchPlayer(world, 100.0f * i + 50.0f, 300.0f);
+    reg.each<Jumper, Velocity>([&](Entity, Jumper&, Velocity& v) { v.x = world.moveSpeed; });
+
+    enum { SYS_GRAVITY, SYS_MOVEMENT, SYS_LANDING, SYS_PICKUP, SYS_CULLING, SYS_COUNT };
+    const char* names[SYS_COUNT] = { "gravity", "movement", "landing", "pickup", "culling" };
+    double seconds[SYS_COUNT] = {};
+    long long landings = 0, pickups = 0, culled = 0;
+    float cameraY = 0.0f;
+
+    using Clock = std::chrono::steady_clock;
+    for (int t = 0; t < ticks; ++t) {
+        auto t0 = Clock::now();
+        gravitySystem(reg);
+        auto t1 = Clock::now();
+        movementSystem(reg, world.width);
+        auto t2 = Clock::now();
+        landingSystem(reg, world.platforms, world.events);
+        auto t3 = Clock::now();
+        pickupSystem(reg, world.collectibles);
+        pickupEffectSystem(reg, world.events, world.boostDuration);
+        auto t4 = Clock::now();
+        cameraY += climb;
+        culled += cullingSystem(reg, world.platforms, cameraY);
+        world.collectibles.forEachType([&](auto, SortedView& items) { culled += cullingSystem(reg, items, cameraY); });
+        auto t5 = Clock::now();
+
+        for (const GameEvent& e : world.events) {
+            if (e.type == EVENT_LANDED) ++landings;
+            else if (e.type == EVENT_COIN_COLLECTED) pickups += e.value;
+            else if (e.type == EVENT_BOOST_STARTED) ++pickups;
+        }
+        world.events.discardPending();
+
+        // Players that fell behind the camera come back mid-screen; the
+        // level is topped back up above everything else.
+        reg.each<Jumper, Position, Velocity>([&](Entity, Jumper&, Position& p, Velocity& v) {
+            if (p.y >= cameraY) return;
+            p.y = cameraY + 300.0f;
+            v.y = 0.0f;
+        });
+        while (static_cast<int>(reg.size()) < entities + players) spawnEcsBenchEntity(world, rng, topY += step);
+
+        seconds[SYS_GRAVITY] += std::chrono::duration<double>(t1 - t0).count();
+        seconds[SYS_MOVEMENT] += std::chrono::duration<double>(t2 - t1).count();
+        seconds[SYS_LANDING] += std::chrono::duration<double>(t3 - t2).count();
+        seconds[SYS_PICKUP] += std::chrono::duration<double>(t4 - t3).count();
+        seconds[SYS_CULLING] += std::chrono::duration<double>(t5 - t4).count();
+    }
+
+    std::cout << "ecs: " << reg.size() << " entities (" << reg.pool<PlatformComponent>().size() << " platforms, "
+              << reg.pool<Collectible>().size() << " pickups, " << players << " players), "
+              << ticks << " ticks" << std::endl;
+    double total = 0.0;
+    for (int s = 0; s < SYS_COUNT; ++s) {
+        total += seconds[s];
+        std::cout << "  " << names[s] << ": " << seconds[s] * 1e6 / ticks << " us/tick" << std::endl;
+    }
+    std::cout << "  total: " << total * 1e6 / ticks << " us/tick, "
+              << total * 1e9 / ticks / (entities + players) << " ns/entity" << std::endl;
+    std::cout << "  landings: " << landings << "  pickups: " << pickups << "  culled: " << culled << std::endl;
+}
+
+// --farm <episodes> [--threads n] [--policy idle|chase|random|noisy]
+//        [--gravity g] [--jump j] [--boost b] [--spacing s]
+//        [--max-ticks t] [--seed s] [--out file.csv]
+int runFarmCommand(int argc, char** argv) {
+    long long episodes = argc > 2 ? std::atoll(argv[2]) : 100000LL;
+    unsigned threads = std::thread::hardware_concurrency();
+    const Policy* policy = findPolicy("chase");
+    FarmParams params;
+    const char* outPath = "farm_results.csv";
+
+    for (int i = 3; i + 1 < argc; i += 2) {
+        const char* flag = argv[i];
+        const char* value = argv[i + 1];
+        if (std::strcmp(flag, "--threads") == 0) threads = static_cast<unsigned>(std::atoi(value));
+        else if (std::strcmp(flag, "--policy") == 0) policy = findPolicy(value);
+        else if (std::strcmp(flag, "--gravity") == 0) params.gravity = std::stof(value);
+        else if (std::strcmp(flag, "--jump") == 0) params.jumpStrength = std::stof(value);
+        else if (std::strcmp(flag, "--boost") == 0) params.boostedJumpStrength = std::stof(value);
+        else if (std::strcmp(flag, "--spacing") == 0) params.platformSpacing = std::stof(value);
+        else if (std::strcmp(flag, "--max-ticks") == 0) params.maxTicks = std::atoll(value);
+        else if (std::strcmp(flag, "--seed") == 0) params.baseSeed = std::strtoull(value, nullptr, 10);
+        else if (std::strcmp(flag, "--out") == 0) outPath = value;
+        else {
+            std::cerr << "unknown option " << flag << std::endl;
+            return 1;
+        }
+    }
+    if (!policy) {
+        std::cerr << "unknown policy" << std::endl;
+        return 1;
+    }
+
+    ThreadPool pool(threads);
+    FarmResults results = runFarm(episodes, params, *policy, pool);
+    results.print(std::cout);
+
+    std::ofstream out(outPath);
+    results.writeCsv(out);
+    std::cout << "wrote " << outPath << std::endl;
+    return 0;
+}
+
+// --validate <seeds> [--chunks n] [--threads n] [--gravity g] [--jump j]
+//            [--speed s] [--spacing s] [--repair 0|1] [--seed s] [--out file.csv]
+int runValidateCommand(int argc, char** argv) {
+    long long seeds = argc > 2 ? std::atoll(argv[2]) : 100000LL;
+    unsigned threads = std::thread::hardware_concurrency();
+    ValidationParams params;
+    const char* outPath = "reachability.csv";
+
+    for (int i = 3; i + 1 < argc; i += 2) {
+        const char* flag = argv[i];
+        const char* value = argv[i + 1];
+        if (std::strcmp(flag, "--chunks") == 0) params.chunksPerSeed = std::atoll(value);
+        else if (std::strcmp(flag, "--threads") == 0) threads = static_cast<unsigned>(std::atoi(value));
+        else if (std::strcmp(flag, "--gravity") == 0) params.level.jump.gravity = std::stof(value);
+        else if (std::strcmp(flag, "--jump") == 0) params.level.jump.jumpStrength = std::stof(value);
+        else if (std::strcmp(flag, "--speed") == 0) params.level.jump.moveSpeed = std::stof(value);
+        else if (std::strcmp(flag, "--spacing") == 0) params.level.spacing = std::stof(value);
+        else if (std::strcmp(flag, "--repair") == 0) params.level.repair = std::atoi(value) != 0;
+        else if (std::strcmp(flag, "--seed") == 0) params.baseSeed = std::strtoull(value, nullptr, 10);
+        else if (std::strcmp(flag, "--out") == 0) outPath = value;
+        else {
+            std::cerr << "unknown option " << flag << std::endl;
+            return 1;
+        }
+    }
+
+    ThreadPool pool(threads);
+    ValidationResults results = runValidation(seeds, params, pool);
+    results.print(std::cout);
+
+    std::ofstream out(outPath);
+    results.writeCsv(out);
+    std::cout << "wrote " << outPath << std::endl;
+    return 0;
 }
 
 int main(int argc, char** argv) {
-    srand(static_cast<unsigned int>(time(0)));
+    gameSeed = static_cast<uint64_t>(time(0));
+
+    if (argc > 1 && std::strcmp(argv[1], "--bench") == 0) {
+        runTickBenchmark(argc > 2 ? std::atoll(argv[2]) : 10000000LL, false);
+        return 0;
+    }
+    if (argc > 1 && std::strcmp(argv[1], "--bench-streamed") == 0) {
+        runTickBenchmark(argc > 2 ? std::atoll(argv[2]) : 10000000LL, true);
+        return 0;
+    }
+    if (argc > 1 && std::strcmp(argv[1], "--soak") == 0) {
+        runAllocationSoak(argc > 2 ? std::atof(argv[2]) : 3600.0);
+        return 0;
+    }
+    if (argc > 1 && std::strcmp(argv[1], "--bench-platforms") == 0) {
+        runPlatformLayoutBenchmark();
+        return 0;
+    }
+    if (argc > 1 && std::strcmp(argv[1], "--bench-ecs") == 0) {
+        runEcsBenchmark();
+        return 0;
+    }
+    if (argc > 1 && std::strcmp(argv[1], "--bench-landing") == 0) {
+        runLandingBenchmark();
+        return 0;
+    }
+    if (argc > 1 && std::strcmp(argv[1], "--farm") == 0) {
+        return runFarmCommand(argc, argv);
+    }
+    if (argc > 1 && std::strcmp(argv[1], "--validate") == 0) {
+        return runValidateCommand(argc, argv);
+    }
 
     glutInit(&argc, argv);
     glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB);
@@ -459,12 +1253,36 @@ int main(int argc, char** argv) {
     glutCreateWindow("Simple Jump Game");
 
     glClearColor(0.8f, 0.9f, 1.0f, 1.0f);
+    initRenderers();
+
+    if (argc > 1 && std::strcmp(argv[1], "--bench-render") == 0) {
+        reshape(windowWidth, windowHeight);
+        runRenderBenchmark();
+        releaseRenderers();
+        return 0;
+    }
+
+    GlFunctions& gl = glFunctions();
+    if (gl.swapInterval) gl.swapInterval(1);
 
     glutDisplayFunc(display);
     glutKeyboardFunc(keyboard);
     glutKeyboardUpFunc(keyboardUp);
     glutReshapeFunc(reshape);
-    glutTimerFunc(0, timer, 0);
+    glutIdleFunc(idle);
+    glutCloseFunc(releaseRenderers);
+    atexit(printStepPacing);
+#if FRAME_PROFILER
+    frameProfiler().enabled = true;
+    atexit(dumpFrameProfile);
+#endif
+    atexit(printRates);
+    // Registered last so it runs first: the simulation thread is joined
+    // before anything reads its state.
+    atexit(stopSimulation);
+
+    renderRate.start = std::chrono::steady_clock::now();
+    startSimulation();
 
     glutMainLoop();
     return 0;